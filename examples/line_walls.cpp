@@ -302,15 +302,17 @@ int main()
 
     tqdm bar;
 
+    // I campioni sono eventi dell'engine: una sola chiamata a run
+    std::vector<double> sample_times;
     for (unsigned int i = 0; i <= N_SAMPLES; ++i)
-    {
-        my_engine.run(i * time_interval); // Run UNTIL time
-        
+        sample_times.push_back(i * time_interval);
+
+    my_engine.schedule(sample_times, [&](const size_t &i, const double &sample_time) {
         bar.progress(i, N_SAMPLES);
-        
+
         // Report di ogni molecola sul file di testo...
         my_engine.each<molecule>([&](const molecule &current_molecule) {
-            out_all << std ::fixed << std ::setprecision(2) << i * time_interval << "\t"
+            out_all << std ::fixed << std ::setprecision(2) << sample_time << "\t"
                     << current_molecule.mass() << "\t"
                     << std ::fixed << std ::setprecision(8) << current_molecule.energy() << "\t"
                     << std ::fixed << std ::setprecision(8) << current_molecule.position().x << "\t"
@@ -321,11 +323,13 @@ int main()
 
         // Graphics
         my_window.draw(my_engine);
-        
+
 #ifdef __graphics__
         usleep(10.e4);
 #endif
-    }
+    });
+
+    my_engine.run(SIMULATION_TIME); // Run UNTIL time
 }
 
 #endif
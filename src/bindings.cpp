@@ -13,12 +13,107 @@ namespace py = pybind11;
 #include <cmath>
 #include <sstream>
 #include <string>
+#include <stdexcept>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 
 #include "engine/engine.hpp"
 #include "graphics/window.h"
 
+// Kinds of the events recorded by engine_wrapper's tracking
+
+enum event_kind : uint8_t {molecule_molecule, molecule_xline};
+
+// Tracking records, stored column by column
+
+typedef py::array_t<double, py::array::c_style | py::array::forcecast> columns;
+
+struct tracking_columns
+{
+    std::vector<uint64_t> id;
+    std::vector<uint8_t> kind;
+    std::vector<double> time;
+    std::vector<double> mass;
+    std::vector<double> energy;
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> vx;
+    std::vector<double> vy;
+
+    void push(const size_t &id, const event_kind &kind, const double &time, const double &mass, const double &energy, const vec &position, const vec &velocity)
+    {
+        this->id.push_back(id);
+        this->kind.push_back(kind);
+        this->time.push_back(time);
+        this->mass.push_back(mass);
+        this->energy.push_back(energy);
+        this->x.push_back(position.x);
+        this->y.push_back(position.y);
+        this->vx.push_back(velocity.x);
+        this->vy.push_back(velocity.y);
+    }
+
+    size_t size() const
+    {
+        return this->id.size();
+    }
+
+    void clear()
+    {
+        *this = tracking_columns();
+    }
+};
+
+// Hands the storage of a column over to a NumPy array (no copy): the
+// column is left empty and the array frees the buffer when collected.
+
+template <typename type> void destroy(void *pointer)
+{
+    delete reinterpret_cast<std::vector<type> *>(pointer);
+}
+
+template <typename type> py::array_t<type> release(std::vector<type> &column)
+{
+    std::vector<type> *owner = new std::vector<type>(std::move(column));
+    column = std::vector<type>();
+
+    py::capsule base(owner, &destroy<type>);
+    return py::array_t<type>(owner->size(), owner->data(), base);
+}
+
+py::dict release(tracking_columns &tracking)
+{
+    py::dict data;
+
+    data["id"] = release(tracking.id);
+    data["kind"] = release(tracking.kind);
+    data["time"] = release(tracking.time);
+    data["mass"] = release(tracking.mass);
+    data["energy"] = release(tracking.energy);
+    data["x"] = release(tracking.x);
+    data["y"] = release(tracking.y);
+    data["vx"] = release(tracking.vx);
+    data["vy"] = release(tracking.vy);
+
+    return data;
+}
+
+// Columns exported by engine_wrapper::get_state
+
+const std::vector<std::string> state_columns = {"id", "time", "mass", "radius", "energy", "x", "y", "vx", "vy", "orientation", "angular_velocity"};
+
+class tracking_stream;
+
 class engine_wrapper
 {
+    // Friends
+
+    friend class tracking_stream;
+
     // Members
 
     std::default_random_engine re;
@@ -26,15 +121,28 @@ class engine_wrapper
     double time;
     enum tags {traced1, traced2, traced3};
 
-    std::vector<size_t> ids;
+    tracking_columns tracking;
 
-    std::vector<std::tuple<unsigned int, std::string, double, double, double, double, double, double, double>> tracking;
+    // Background simulation (run_async and stream_tracking)
+
+    std::thread worker;
+    std::mutex lock;
+    std::condition_variable ready;
+    std::deque<tracking_columns> batches;
+    std::exception_ptr failure;
+    bool running = false;
+    bool batching = false;
+    bool stopping = false;
 
 public:
 
     // CONSTRUCTOR
 
-    engine_wrapper(unsigned int grid_size=1, bool rand_seed=false) : my_engine(grid_size), time(0.0)
+    engine_wrapper(unsigned int grid_size=1, bool rand_seed=false) : engine_wrapper(grid_size, grid_size, rand_seed)
+    {
+    }
+
+    engine_wrapper(unsigned int grid_x, unsigned int grid_y, bool rand_seed) : my_engine(grid_x, grid_y), time(0.0)
     {
         if(rand_seed)
             re.seed(42);
@@ -42,63 +150,71 @@ public:
         my_engine.on<events ::molecule>(
             traced1,
             [&](const report<events ::molecule> my_report) {
-                if (std ::find(ids.begin(), ids.end(), my_report.alpha.id()) != ids.end())
-                {
-                    std::tuple<unsigned int, std::string, double, double, double, double, double, double, double> data(
+                if (my_report.alpha.tagged(traced1))
+                    tracking.push(
                         my_report.alpha.id(),
-                        "molecule-molecule",
+                        molecule_molecule,
                         my_report.time(),
                         my_report.alpha.mass(),
                         my_report.alpha.energy.after(),
-                        my_report.alpha.position().x,
-                        my_report.alpha.position().y,
-                        my_report.alpha.velocity.after().x,
-                        my_report.alpha.velocity.after().y);
-                    tracking.push_back(data);
-                }
-                if (std ::find(ids.begin(), ids.end(), my_report.beta.id()) != ids.end())
-                {
-                    std::tuple<unsigned int, std::string, double, double, double, double, double, double, double> data(
+                        my_report.alpha.position(),
+                        my_report.alpha.velocity.after());
+
+                if (my_report.beta.tagged(traced1))
+                    tracking.push(
                         my_report.beta.id(),
-                        "molecule-molecule",
+                        molecule_molecule,
                         my_report.time(),
                         my_report.beta.mass(),
                         my_report.beta.energy.after(),
-                        my_report.beta.position().x,
-                        my_report.beta.position().y,
-                        my_report.beta.velocity.after().x,
-                        my_report.beta.velocity.after().y);
-                    tracking.push_back(data);
-                }
+                        my_report.beta.position(),
+                        my_report.beta.velocity.after());
             });
 
         my_engine.on<events ::xline>(
             traced1,
             [&](const report<events ::xline> my_report) {
-                std::tuple<unsigned int, std::string, double, double, double, double, double, double, double> data(
+                tracking.push(
                     my_report.id(),
-                    "molecule-xline",
+                    molecule_xline,
                     my_report.time(),
                     my_report.mass(),
                     my_report.energy.after(),
-                    my_report.position().x,
-                    my_report.position().y,
-                    my_report.velocity.after().x,
-                    my_report.velocity.after().y);
-                tracking.push_back(data);
+                    my_report.position(),
+                    my_report.velocity.after());
             });
     }
 
+    // DESTRUCTOR
+
+    ~engine_wrapper()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+
+        if(worker.joinable())
+        {
+            py::gil_scoped_release release;
+            worker.join();
+        }
+    }
+
     // Public Methods
 
     void add_basic_xline(double position)
     {
+        ensure_idle();
+
         xline my_line(position);
         my_engine.add(my_line);
     }
 
     void add_fixed_xline(double position, double temperature)
     {
+        ensure_idle();
+
         xline my_line(
             position,
             temperature,
@@ -111,6 +227,8 @@ public:
 
     void add_random_xline(double position, double temperature)
     {
+        ensure_idle();
+
         xline my_line(
             position,
             temperature,
@@ -124,6 +242,8 @@ public:
 
     void add_multiplicative_xline(double position, double elasticity)
     {
+        ensure_idle();
+
         xline my_line(
             position,
             elasticity,
@@ -134,8 +254,15 @@ public:
         my_engine.add(my_line);
     }
 
-    unsigned int add_molecule(double x, double y, std::vector<double> x_atom, std::vector<double> y_atom, std::vector<double> r_atom, std::vector<double> mass_atom, double vx, double vy, double orientation, double ang_rotation, bool tracking)
+    uint64_t add_molecule(double x, double y, std::vector<double> x_atom, std::vector<double> y_atom, std::vector<double> r_atom, std::vector<double> mass_atom, double vx, double vy, double orientation, double ang_rotation, bool tracking)
     {
+        ensure_idle();
+
+#ifdef __monatomic__
+        if(x_atom.size() != 1)
+            throw std::invalid_argument("this build only supports single atom molecules");
+#endif
+
         std::vector<atom> atoms;
 
         for(int i = 0; i < x_atom.size(); i++)
@@ -151,18 +278,80 @@ public:
             ang_rotation
         );
 
-        unsigned int my_molecule_id = my_engine.add(my_molecule);
+        uint64_t my_molecule_id = my_engine.add(my_molecule);
 
         if(tracking)
-        {
             my_engine.tag(my_molecule_id, traced1);
-            ids.push_back(my_molecule_id);
-        }
         return my_molecule_id;
     }
     
+    // Bulk version of add_molecule: every molecule is a copy of the same atom
+    // template, placed according to the i-th entry of the NumPy columns.
+    // Optional columns default to zero; tags is a bitmask of the tags enum.
+    py::array_t<uint64_t> add_molecules(columns x, columns y, columns vx, columns vy, std::vector<double> x_atom, std::vector<double> y_atom, std::vector<double> r_atom, std::vector<double> mass_atom, py::object orientation, py::object ang_rotation, py::object tags)
+    {
+        ensure_idle();
+
+        size_t count = x.size();
+
+        if(x.ndim() != 1 || y.size() != count || vx.size() != count || vy.size() != count)
+            throw std::invalid_argument("x, y, vx and vy must be 1-D arrays of the same length");
+
+        if(x_atom.empty() || y_atom.size() != x_atom.size() || r_atom.size() != x_atom.size() || mass_atom.size() != x_atom.size())
+            throw std::invalid_argument("the atom template lists must be non-empty and of the same length");
+
+#ifdef __monatomic__
+        if(x_atom.size() != 1)
+            throw std::invalid_argument("this build only supports single atom molecules");
+#endif
+
+        columns orientations = optional_column(orientation, count, "orientation");
+        columns ang_rotations = optional_column(ang_rotation, count, "ang_rotation");
+
+        py::array_t<uint8_t, py::array::c_style | py::array::forcecast> masks;
+
+        if(!tags.is_none())
+        {
+            masks = tags.cast<py::array_t<uint8_t, py::array::c_style | py::array::forcecast>>();
+
+            if(masks.size() != count)
+                throw std::invalid_argument("tags must have one entry per molecule");
+        }
+
+        std::vector<atom> atoms;
+
+        for(size_t i = 0; i < x_atom.size(); i++)
+            atoms.push_back(atom({x_atom[i], y_atom[i]}, mass_atom[i], r_atom[i]));
+
+        molecule prototype(atoms);
+
+        py::array_t<uint64_t> ids(count);
+        uint64_t *id = ids.mutable_data();
+
+        const double *xs = x.data(), *ys = y.data(), *vxs = vx.data(), *vys = vy.data();
+        const double *os = orientation.is_none() ? nullptr : orientations.data();
+        const double *ws = ang_rotation.is_none() ? nullptr : ang_rotations.data();
+        const uint8_t *ts = tags.is_none() ? nullptr : masks.data();
+
+        my_engine.reserve(count);
+
+        for(size_t i = 0; i < count; i++)
+        {
+            id[i] = my_engine.add(prototype, vec(xs[i], ys[i]), vec(vxs[i], vys[i]), os ? os[i] : 0., ws ? ws[i] : 0.);
+
+            if(ts)
+                for(uint8_t tag = traced1; tag <= traced3; tag++)
+                    if(ts[i] & (1 << tag))
+                        my_engine.tag(id[i], tag);
+        }
+
+        return ids;
+    }
+
     std::vector<std::tuple<double, double, double, double, double, double, double, double>> get_sim_photo()
     {
+        ensure_idle();
+
         std::vector<std::tuple<double, double, double, double, double, double, double, double>> data_vec;
 
         my_engine.each<molecule>([&](const molecule &current_molecule) {
@@ -181,38 +370,485 @@ public:
         return data_vec;
     }
 
-    std::vector<std::tuple<unsigned int, std::string, double, double, double, double, double, double, double>> get_tracking_data()
+    // Fills one float64 column per requested name, writing directly into the
+    // arrays of `out` when they already have the right shape (so a dict can be
+    // reused across frames), allocating fresh ones otherwise.
+    py::dict get_state(const std::vector<std::string> &columns, py::object out)
+    {
+        ensure_idle();
+
+        py::dict state = out.is_none() ? py::dict() : out.cast<py::dict>();
+        const size_t size = my_engine.molecule_count();
+
+        std::vector<size_t> indices;
+        std::vector<double *> buffers;
+
+        for(const std::string &name : columns)
+        {
+            size_t index = state_index(name);
+            py::object current = state.contains(name) ? py::object(state[name.c_str()]) : py::object(py::none());
+
+            bool reusable = py::isinstance<py::array_t<double, py::array::c_style>>(current);
+
+            if(reusable)
+            {
+                py::array_t<double, py::array::c_style> buffer = current.cast<py::array_t<double, py::array::c_style>>();
+                reusable = buffer.ndim() == 1 && static_cast<size_t>(buffer.size()) == size && buffer.writeable();
+            }
+
+            if(!reusable)
+                state[name.c_str()] = py::array_t<double>(size);
+
+            py::array_t<double, py::array::c_style> buffer = py::object(state[name.c_str()]).cast<py::array_t<double, py::array::c_style>>();
+
+            indices.push_back(index);
+            buffers.push_back(buffer.mutable_data());
+        }
+
+        size_t row = 0;
+
+        my_engine.each<molecule>([&](const molecule &current_molecule) {
+            for(size_t i = 0; i < indices.size(); i++)
+                buffers[i][row] = state_value(current_molecule, indices[i]);
+
+            row++;
+        });
+
+        return state;
+    }
+
+    // Runs for time_interval in a single engine call, sampling the given
+    // columns at `samples` evenly spaced times (the last one at the end of the
+    // run). Returns the sample times and one (samples, molecules) array per
+    // column, filled in place by sample events with the GIL released. If the
+    // watchdog stops the run, the samples it did not reach are NaN.
+    py::dict run_sampled(double time_interval, size_t samples, const std::vector<std::string> &columns)
+    {
+        ensure_idle();
+
+        const size_t size = my_engine.molecule_count();
+
+        py::dict state;
+        py::array_t<double> times(samples);
+
+        std::vector<double> schedule(samples);
+        std::vector<size_t> indices;
+        std::vector<double *> buffers;
+
+        for(size_t i = 0; i < samples; i++)
+            schedule[i] = times.mutable_data()[i] = time + time_interval * (i + 1) / samples;
+
+        state["time"] = times;
+
+        for(const std::string &name : columns)
+        {
+            py::array_t<double> buffer(std::vector<ssize_t>{(ssize_t) samples, (ssize_t) size});
+            state[name.c_str()] = buffer;
+
+            indices.push_back(state_index(name));
+            buffers.push_back(buffer.mutable_data());
+        }
+
+        size_t taken = 0;
+
+        claim();
+
+        try
+        {
+            py::gil_scoped_release release;
+
+            my_engine.schedule(schedule, [&](const size_t &sample, const double &) {
+                size_t row = sample * size;
+                taken = sample + 1;
+
+                my_engine.each<molecule>([&](const molecule &current_molecule) {
+                    for(size_t i = 0; i < indices.size(); i++)
+                        buffers[i][row] = state_value(current_molecule, indices[i]);
+
+                    row++;
+                });
+            });
+
+            my_engine.run(time + time_interval);
+            my_engine.unschedule();
+
+            time = my_engine.time(); // Short of the target if the watchdog stopped the run
+
+            for(double *buffer : buffers)
+                std::fill(buffer + taken * size, buffer + samples * size, NAN);
+        }
+        catch(...)
+        {
+            my_engine.unschedule();
+            settle();
+            throw;
+        }
+
+        settle();
+        return state;
+    }
+
+    // Returns the records gathered so far as a dict of NumPy columns. The
+    // buffers are handed over to Python without copying, so tracking starts
+    // over empty after each call.
+    py::dict get_tracking_data()
     {
-        return tracking;
+        ensure_idle();
+        return release(tracking);
+    }
+
+    size_t tracking_size()
+    {
+        ensure_idle();
+        return tracking.size();
     }
 
     void clear_tracking_data()
     {
+        ensure_idle();
         tracking.clear();
     }
 
-    void run(double time_interval)
+    // Inelastic collapse: TC model and watchdog (off by default), see engine.
+    void collapse(double tc)
+    {
+        ensure_idle();
+        my_engine.collapse(tc);
+    }
+
+    void watchdog(double interval, size_t burst)
+    {
+        ensure_idle();
+        my_engine.watchdog(interval, burst);
+    }
+
+    // Ids of the molecules flagged by the watchdog so far.
+    std::vector<uint64_t> collapsed()
+    {
+        ensure_idle();
+        return std::vector<uint64_t>(my_engine.collapsed().begin(), my_engine.collapsed().end());
+    }
+
+    // Without arguments the engine picks (and keeps adapting) its own grid.
+    void regrid(unsigned int grid_x, unsigned int grid_y, unsigned int levels)
+    {
+        ensure_idle();
+
+        if(!grid_x)
+            my_engine.regrid();
+        else
+            my_engine.regrid(grid_x, grid_y ? grid_y : grid_x, levels ? levels : 1);
+    }
+
+    std::tuple<size_t, size_t> grid_size()
+    {
+        ensure_idle();
+        return std::make_tuple(my_engine.xfineness(), my_engine.yfineness());
+    }
+
+    size_t grid_levels()
+    {
+        ensure_idle();
+        return my_engine.levels();
+    }
+
+    // Bound with the GIL released: only C++ state is touched, and the engine
+    // is marked as running so that other Python threads cannot get at it.
+    // Returns false if the watchdog stopped the run (see collapsed()).
+    bool run(double time_interval)
+    {
+        bool reached = false;
+
+        claim();
+
+        try
+        {
+            reached = my_engine.run(time + time_interval);
+        }
+        catch(...)
+        {
+            settle();
+            throw;
+        }
+
+        time = my_engine.time();
+        settle();
+
+        return reached;
+    }
+
+    // Runs the simulation on a background thread and returns immediately:
+    // poll it with done() and collect it with wait(). Every other method
+    // raises while the simulation is in progress.
+    void run_async(double time_interval)
+    {
+        launch(time_interval, time_interval, false);
+    }
+
+    bool done()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return !running;
+    }
+
+    void wait()
+    {
+        {
+            py::gil_scoped_release release;
+
+            if(worker.joinable())
+                worker.join();
+        }
+
+        rethrow();
+    }
+
+    // Runs the simulation on a background thread in steps of batch_interval,
+    // returning an iterator that yields the tracking data of each step (as
+    // get_tracking_data does) while the following ones are being simulated.
+    tracking_stream stream_tracking(double time_interval, double batch_interval);
+
+private:
+
+    // Private methods
+
+    static columns optional_column(py::object column, size_t count, const char *name)
+    {
+        if(column.is_none())
+            return columns();
+
+        columns values = column.cast<columns>();
+
+        if(values.size() != count)
+            throw std::invalid_argument(std::string(name) + " must have one entry per molecule");
+
+        return values;
+    }
+
+    void ensure_idle()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+
+        if(running)
+            throw std::runtime_error("the engine is already running");
+    }
+
+    // Marks the engine as running, raising if it already is: the check and the
+    // update happen under the same lock, so two threads cannot both get in.
+    void claim()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+
+        if(running)
+            throw std::runtime_error("the engine is already running");
+
+        running = true;
+    }
+
+    void settle()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        running = false;
+        ready.notify_all();
+    }
+
+    void rethrow()
     {
-        my_engine.run(time + time_interval);
-        time += time_interval;
+        std::exception_ptr pending;
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            std::swap(pending, failure);
+        }
+
+        if(pending)
+            std::rethrow_exception(pending);
+    }
+
+    void launch(double time_interval, double batch_interval, bool batch)
+    {
+        if(!(batch_interval > 0))
+            throw std::invalid_argument("the batch interval must be positive");
+
+        claim();
+
+        if(worker.joinable())
+            worker.join();
+
+        try
+        {
+            rethrow();
+        }
+        catch(...)
+        {
+            settle();
+            throw;
+        }
+
+        batching = batch;
+        stopping = false;
+        batches.clear();
+
+        double target = time + time_interval;
+
+        worker = std::thread([this, target, batch_interval]() {
+            try
+            {
+                while(time < target)
+                {
+                    double step = std::min(time + batch_interval, target);
+                    bool reached = my_engine.run(step);
+                    time = my_engine.time();
+
+                    std::lock_guard<std::mutex> guard(lock);
+
+                    if(batching)
+                    {
+                        batches.push_back(std::move(tracking));
+                        tracking.clear();
+                        ready.notify_all();
+                    }
+
+                    if(stopping || !reached)
+                        break; // A run stopped by the watchdog is not resumed: see collapsed()
+                }
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                failure = std::current_exception();
+            }
+
+            settle();
+        });
+    }
+
+    // Blocks (with the GIL released) until a batch is available; returns
+    // false once the background simulation is over and all batches are out.
+    bool next_batch(tracking_columns &batch)
+    {
+        {
+            py::gil_scoped_release release;
+            std::unique_lock<std::mutex> guard(lock);
+
+            ready.wait(guard, [this]() { return !batches.empty() || !running; });
+
+            if(!batches.empty())
+            {
+                batch = std::move(batches.front());
+                batches.pop_front();
+                return true;
+            }
+        }
+
+        wait();
+        return false;
+    }
+
+    static size_t state_index(const std::string &name)
+    {
+        size_t index = std::find(state_columns.begin(), state_columns.end(), name) - state_columns.begin();
+
+        if(index == state_columns.size())
+            throw std::invalid_argument("unknown state column '" + name + "'");
+
+        return index;
+    }
+
+    static double state_value(const molecule &current_molecule, const size_t &index)
+    {
+        switch(index)
+        {
+            case 0: return current_molecule.tag.id();
+            case 1: return current_molecule.time();
+            case 2: return current_molecule.mass();
+            case 3: return current_molecule.radius();
+            case 4: return current_molecule.energy();
+            case 5: return current_molecule.position().x;
+            case 6: return current_molecule.position().y;
+            case 7: return current_molecule.velocity().x;
+            case 8: return current_molecule.velocity().y;
+            case 9: return current_molecule.orientation();
+            default: return current_molecule.angular_velocity();
+        }
     }
 };
 
+// Python iterator over the tracking batches of engine_wrapper::stream_tracking
+
+class tracking_stream
+{
+    // Members
+
+    engine_wrapper &wrapper;
+
+public:
+
+    // CONSTRUCTOR
+
+    tracking_stream(engine_wrapper &wrapper) : wrapper(wrapper)
+    {
+    }
+
+    // Public Methods
+
+    py::dict next()
+    {
+        tracking_columns batch;
+
+        if(!wrapper.next_batch(batch))
+            throw py::stop_iteration();
+
+        return release(batch);
+    }
+};
+
+tracking_stream engine_wrapper::stream_tracking(double time_interval, double batch_interval)
+{
+    launch(time_interval, batch_interval, true);
+    return tracking_stream(*this);
+}
+
 // PYTHON BINDINGS
 
 PYBIND11_MODULE(engine_wrapper, m)
 {
     py::add_ostream_redirect(m, "ostream_redirect");
 
+    py::enum_<event_kind>(m, "event_kind")
+        .value("molecule_molecule", molecule_molecule)
+        .value("molecule_xline", molecule_xline)
+        .export_values();
+
+    py::class_<tracking_stream>(m, "tracking_stream")
+        .def("__iter__", [](tracking_stream &stream) -> tracking_stream & { return stream; }, py::return_value_policy::reference_internal)
+        .def("__next__", &tracking_stream::next);
+
     py::class_<engine_wrapper>(m, "engine_wrapper")
         .def(py::init<int, bool>())
+        .def(py::init<int, int, bool>())
         .def("add_basic_xline", &engine_wrapper::add_basic_xline)
         .def("add_random_xline", &engine_wrapper::add_random_xline)
         .def("add_multiplicative_xline", &engine_wrapper::add_multiplicative_xline)
         .def("add_molecule", &engine_wrapper::add_molecule)
+        .def("add_molecules", &engine_wrapper::add_molecules, py::arg("x"), py::arg("y"), py::arg("vx"), py::arg("vy"), py::arg("x_atom"), py::arg("y_atom"), py::arg("r_atom"), py::arg("mass_atom"), py::arg("orientation") = py::none(), py::arg("ang_rotation") = py::none(), py::arg("tags") = py::none())
         .def("get_sim_photo", &engine_wrapper::get_sim_photo)
+        .def("get_state", &engine_wrapper::get_state, py::arg("columns") = state_columns, py::arg("out") = py::none())
+        .def("run_sampled", &engine_wrapper::run_sampled, py::arg("time_interval"), py::arg("samples"), py::arg("columns") = state_columns)
         .def("get_tracking_data", &engine_wrapper::get_tracking_data)
-        .def("run", &engine_wrapper::run);
+        .def("tracking_size", &engine_wrapper::tracking_size)
+        .def("clear_tracking_data", &engine_wrapper::clear_tracking_data)
+        .def("regrid", &engine_wrapper::regrid, py::arg("grid_x") = 0, py::arg("grid_y") = 0, py::arg("levels") = 1)
+        .def("grid_size", &engine_wrapper::grid_size)
+        .def("grid_levels", &engine_wrapper::grid_levels)
+        .def("collapse", &engine_wrapper::collapse, py::arg("tc"))
+        .def("watchdog", &engine_wrapper::watchdog, py::arg("interval"), py::arg("burst"))
+        .def("collapsed", &engine_wrapper::collapsed)
+        .def("run", &engine_wrapper::run, py::call_guard<py::gil_scoped_release>())
+        .def("run_async", &engine_wrapper::run_async)
+        .def("done", &engine_wrapper::done)
+        .def("wait", &engine_wrapper::wait)
+        .def("stream_tracking", &engine_wrapper::stream_tracking, py::arg("time_interval"), py::arg("batch_interval"), py::keep_alive<0, 1>());
 }
 
 #endif
@@ -0,0 +1,49 @@
+// Forward declarations
+
+#ifndef __nobb__callback__callbacks__callbackforward
+#define __nobb__callback__callbacks__callbackforward
+
+template <typename, typename = void> class callback;
+
+#endif
+
+#if !defined(__forward__) && !defined(__nobb__callback__callbacks__sample__h)
+#define __nobb__callback__callbacks__sample__h
+
+// Forward includes
+
+#define __forward__
+#include "event/events/sample.h"
+#undef __forward__
+
+template <> class callback <events :: sample, void>
+{
+public:
+
+  // Destructor
+
+  virtual ~callback() {};
+
+  // Methods
+
+  virtual void trigger(const events :: sample &) = 0;
+};
+
+template <typename lambda> class callback <events :: sample, lambda> : public callback <events :: sample, void>
+{
+  // Members
+
+  lambda _callback;
+
+public:
+
+  // Constructors
+
+  callback(const lambda &);
+
+  // Methods
+
+  void trigger(const events :: sample &);
+};
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef __nobb__callback__callbacks__sample__hpp
+#define __nobb__callback__callbacks__sample__hpp
+
+#include "sample.h"
+#include "event/events/sample.h"
+
+// Constructors
+
+template <typename lambda> callback <events :: sample, lambda> :: callback(const lambda & callback) : _callback(callback)
+{
+}
+
+// Methods
+
+template <typename lambda> void callback <events :: sample, lambda> :: trigger(const events :: sample & event)
+{
+  this->_callback(event.index(), event.time());
+}
+
+#endif
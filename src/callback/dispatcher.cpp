@@ -2,6 +2,7 @@
 #include "event/events/molecule.h"
 #include "event/events/bumper.h"
 #include "event/events/line.h"
+#include "engine/engine.hpp"
 
 // Methods
 
@@ -82,6 +83,11 @@ size_t dispatcher :: add(callback <events :: xline> * event, const uint8_t & tag
     return id;
 }
 
+void dispatcher :: trigger(event * event)
+{
+  event->callback(*this);
+}
+
 void dispatcher :: trigger(const events :: molecule & event)
 {
   auto trigger = [&](callback <events :: molecule> * callback)
@@ -91,38 +97,34 @@ void dispatcher :: trigger(const events :: molecule & event)
 
   this->_molecule.all.each(trigger);
 
-  bool striggered[255];
-  memset(striggered, '\0', 255 * sizeof(bool));
+  const class engine :: tag & alpha = event.alpha().tag;
+  const class engine :: tag & beta = event.beta().tag;
 
-  for(size_t i = 0; i < event.alpha().tag.size(); i++)
-    if(!striggered[event.alpha().tag[i]])
-    {
-      striggered[event.alpha().tag[i]] = true;
-      this->_molecule.stag.map[event.alpha().tag[i]].each(trigger);
-    }
+  // Each tag triggers once, even if both molecules have it
 
-  for(size_t i = 0; i < event.beta().tag.size(); i++)
-    if(!striggered[event.beta().tag[i]])
-    {
-      striggered[event.beta().tag[i]] = true;
-      this->_molecule.stag.map[event.beta().tag[i]].each(trigger);
-    }
+  alpha.each([&](const uint8_t & tag)
+  {
+    this->_molecule.stag.map[tag].each(trigger);
+  });
 
-  bool dtriggered[255][255];
-  for(size_t i = 0; i < 255; i++)
-    memset(dtriggered[i], '\0', 255 * sizeof(bool));
+  beta.each([&](const uint8_t & tag)
+  {
+    if(!(alpha.has(tag)))
+      this->_molecule.stag.map[tag].each(trigger);
+  });
+
+  // Each unordered pair of tags triggers once: (a, b) with a > b was already met as (b, a) if b is a tag of alpha and a a tag of beta
 
-  for(size_t i = 0; i < event.alpha().tag.size(); i++)
-    for(size_t j = 0; j < event.beta().tag.size(); j++)
+  alpha.each([&](const uint8_t & a)
+  {
+    beta.each([&](const uint8_t & b)
     {
-      if(!dtriggered[event.alpha().tag[i]][event.beta().tag[j]])
-      {
-        dtriggered[event.alpha().tag[i]][event.beta().tag[j]] = true;
-        dtriggered[event.beta().tag[j]][event.alpha().tag[i]] = true;
+      if(a > b && alpha.has(b) && beta.has(a))
+        return;
 
-        this->_molecule.dtag.map[event.alpha().tag[i]][event.beta().tag[j]].each(trigger);
-      }
-    }
+      this->_molecule.dtag.map[a][b].each(trigger);
+    });
+  });
 }
 
 void dispatcher :: trigger(const events :: bumper & event)
@@ -134,14 +136,10 @@ void dispatcher :: trigger(const events :: bumper & event)
 
   this->_bumper.all.each(trigger);
 
-  bool striggered[255];
-  memset(striggered, '\0', 255 * sizeof(bool));
-
-  for(size_t i = 0; i < event.molecule().tag.size(); i++)
+  event.molecule().tag.each([&](const uint8_t & tag)
   {
-    striggered[event.molecule().tag[i]] = true;
-    this->_bumper.stag.map[event.molecule().tag[i]].each(trigger);
-  }
+    this->_bumper.stag.map[tag].each(trigger);
+  });
 }
 
 void dispatcher :: trigger(const events :: xline & event)
@@ -153,14 +151,10 @@ void dispatcher :: trigger(const events :: xline & event)
 
   this->_xline.all.each(trigger);
 
-  bool striggered[255];
-  memset(striggered, '\0', 255 * sizeof(bool));
-
-  for(size_t i = 0; i < event.molecule().tag.size(); i++)
+  event.molecule().tag.each([&](const uint8_t & tag)
   {
-    striggered[event.molecule().tag[i]] = true;
-    this->_xline.stag.map[event.molecule().tag[i]].each(trigger);
-  }
+    this->_xline.stag.map[tag].each(trigger);
+  });
 }
 
 template <> void dispatcher :: remove <events :: molecule> (const size_t & id)
@@ -10,6 +10,12 @@ class dispatcher;
 #include <stdint.h>
 #include <tuple>
 
+// Forward includes
+
+#define __forward__
+#include "event/event.h"
+#undef __forward__
+
 // Includes
 
 #include "callbacks/molecule.hpp"
@@ -20,6 +26,14 @@ class dispatcher;
 
 class dispatcher
 {
+public:
+
+  // Settings
+
+  static constexpr bool empty = false;
+
+private:
+
   // Nested enums
 
   enum type {all, stag, dtag};
@@ -34,13 +48,13 @@ class dispatcher
     struct
     {
       hashtable <size_t, std :: tuple <callback <events :: molecule> *, uint8_t>> handles;
-      set <callback <events :: molecule> *> map[255];
+      set <callback <events :: molecule> *> map[256];
     } stag;
 
     struct
     {
       hashtable <size_t, std :: tuple <callback <events :: molecule> *, uint8_t, uint8_t>> handles;
-      set <callback <events :: molecule> *> map[255][255];
+      set <callback <events :: molecule> *> map[256][256];
     } dtag;
   } _molecule;
 
@@ -52,7 +66,7 @@ class dispatcher
     struct
     {
       hashtable <size_t, std :: tuple <callback <events :: bumper> *, uint8_t>> handles;
-      set <callback <events :: bumper> *> map[255];
+      set <callback <events :: bumper> *> map[256];
     } stag;
   } _bumper;
 
@@ -64,7 +78,7 @@ class dispatcher
     struct
     {
       hashtable <size_t, std :: tuple <callback <events :: xline> *, uint8_t>> handles;
-      set <callback <events :: xline> *> map[255];
+      set <callback <events :: xline> *> map[256];
     } stag;
   } _xline;
 
@@ -82,6 +96,7 @@ public:
   size_t add(callback <events :: xline> *);
   size_t add(callback <events :: xline> *, const uint8_t &);
 
+  void trigger(event *);
   void trigger(const events :: molecule &);
   void trigger(const events :: bumper &);
   void trigger(const events :: xline &);
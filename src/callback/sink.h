@@ -0,0 +1,88 @@
+// Forward declarations
+
+template <typename...> class sink;
+
+#if !defined(__forward__) && !defined(__nobb__callback__sink__h)
+#define __nobb__callback__sink__h
+
+// Libraries
+
+#include <stddef.h>
+#include <stdint.h>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+// Forward includes
+
+#define __forward__
+#include "event/event.h"
+#include "event/events/molecule.h"
+#include "event/events/bumper.h"
+#include "event/events/line.h"
+#undef __forward__
+
+// Includes
+
+#include "event/reports/molecule.h"
+#include "event/reports/bumper.h"
+#include "event/reports/line.h"
+
+template <typename... observers> class sink
+{
+public:
+
+  // Settings
+
+  static constexpr bool empty = (sizeof...(observers) == 0);
+
+private:
+
+  // Service nested classes
+
+  template <typename etype, typename otype> struct accepts
+  {
+    template <typename vtype> static uint8_t sfinae(...);
+    template <typename vtype> static uint32_t sfinae(decltype(std :: declval <vtype &> ()(std :: declval <const report <etype> &> ())) *);
+
+    static constexpr bool value = sizeof(sfinae <otype> (0)) == sizeof(uint32_t);
+  };
+
+  template <typename etype> struct listens
+  {
+    static constexpr bool value = !(std :: is_same <std :: integer_sequence <bool, false, accepts <etype, observers> :: value...>, std :: integer_sequence <bool, accepts <etype, observers> :: value..., false>> :: value);
+  };
+
+  // Members
+
+  std :: tuple <observers...> _observers;
+
+public:
+
+  // Constructors
+
+  sink(const observers & ...);
+
+  // Getters
+
+  template <typename otype> otype & get();
+
+  // Methods
+
+  void trigger(event *);
+
+private:
+
+  // Private methods
+
+  template <typename etype> void notify(const etype &, std :: true_type);
+  template <typename etype> void notify(const etype &, std :: false_type);
+  template <typename etype, size_t... indices> void notify(const report <etype> &, std :: index_sequence <indices...>);
+
+  // Static private methods
+
+  template <typename etype, typename otype> static void invoke(otype &, const report <etype> &, std :: true_type);
+  template <typename etype, typename otype> static void invoke(otype &, const report <etype> &, std :: false_type);
+};
+
+#endif
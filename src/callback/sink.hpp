@@ -0,0 +1,77 @@
+#ifndef __nobb__callback__sink__hpp
+#define __nobb__callback__sink__hpp
+
+#include "sink.h"
+#include "event/events/molecule.h"
+#include "event/events/bumper.h"
+#include "event/events/line.h"
+
+// Constructors
+
+template <typename... observers> sink <observers...> :: sink(const observers & ... instances) : _observers(instances...)
+{
+}
+
+// Getters
+
+template <typename... observers> template <typename otype> otype & sink <observers...> :: get()
+{
+  return std :: get <otype> (this->_observers);
+}
+
+// Methods
+
+template <typename... observers> void sink <observers...> :: trigger(event * event)
+{
+  switch(event->type())
+  {
+    case event :: molecule_kind:
+    {
+      this->notify((const events :: molecule &) (*event), std :: integral_constant <bool, listens <events :: molecule> :: value> ());
+      break;
+    }
+    case event :: bumper_kind:
+    {
+      this->notify((const events :: bumper &) (*event), std :: integral_constant <bool, listens <events :: bumper> :: value> ());
+      break;
+    }
+    case event :: xline_kind:
+    {
+      this->notify((const events :: xline &) (*event), std :: integral_constant <bool, listens <events :: xline> :: value> ());
+      break;
+    }
+    default:
+    {
+    }
+  }
+}
+
+// Private methods
+
+template <typename... observers> template <typename etype> void sink <observers...> :: notify(const etype & event, std :: true_type)
+{
+  this->notify(report <etype> (event), std :: index_sequence_for <observers...> ());
+}
+
+template <typename... observers> template <typename etype> void sink <observers...> :: notify(const etype &, std :: false_type)
+{
+}
+
+template <typename... observers> template <typename etype, size_t... indices> void sink <observers...> :: notify(const report <etype> & report, std :: index_sequence <indices...>)
+{
+  int expand[] = {0, (invoke(std :: get <indices> (this->_observers), report, std :: integral_constant <bool, accepts <etype, observers> :: value> ()), 0)...};
+  (void) expand;
+}
+
+// Static private methods
+
+template <typename... observers> template <typename etype, typename otype> void sink <observers...> :: invoke(otype & observer, const report <etype> & report, std :: true_type)
+{
+  observer(report);
+}
+
+template <typename... observers> template <typename etype, typename otype> void sink <observers...> :: invoke(otype &, const report <etype> &, std :: false_type)
+{
+}
+
+#endif
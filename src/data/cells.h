@@ -0,0 +1,96 @@
+// Forward declarations
+
+template <typename...> class cells;
+
+#if !defined(__forward__) && !defined(__nobb__data__cells__h)
+#define __nobb__data__cells__h
+
+// Libraries
+
+#include <stddef.h>
+#include <stdint.h>
+#include <tuple>
+#include <utility>
+
+template <typename... types> class cells
+{
+  // Settings
+
+  static constexpr size_t first_alloc = 4;
+
+  // Service nested classes
+
+  struct range
+  {
+    size_t offset;
+    size_t size;
+    size_t alloc;
+  };
+
+  typedef std :: index_sequence_for <types...> columns;
+
+  // Members
+
+  std :: tuple <types * ...> _items; // One array per column, sharing the same ranges
+
+  range * _ranges;
+
+  size_t _cells;
+  size_t _alloc;
+  size_t _end; // First item after the last range
+
+public:
+
+  // Constructors
+
+  cells();
+  cells(const size_t &);
+
+  // Destructor
+
+  ~cells();
+
+  // Getters
+
+  const size_t & size(const size_t &) const;
+
+  // Methods
+
+  size_t add(const size_t &, const types & ...);
+  void remove(const size_t &, const size_t &);
+  void reset(const size_t &);
+
+  template <typename lambda> void each(const size_t &, const lambda &);
+  template <typename lambda> void each(const size_t &, const lambda &) const;
+
+  template <size_t column> typename std :: tuple_element <column, std :: tuple <types...>> :: type * get(const size_t &);
+  template <size_t column> const typename std :: tuple_element <column, std :: tuple <types...>> :: type * get(const size_t &) const;
+
+private:
+
+  // Private methods
+
+  void grow(const size_t &);
+  void relayout(const size_t &);
+
+  void allocate();
+  template <size_t... indices> void store(const size_t &, std :: index_sequence <indices...>, const types & ...);
+  template <size_t... indices> void move(const std :: tuple <types * ...> &, const size_t &, const size_t &, std :: index_sequence <indices...>);
+  template <typename lambda, size_t... indices> void call(const size_t &, const lambda &, std :: index_sequence <indices...>);
+  template <typename lambda, size_t... indices> void call(const size_t &, const lambda &, std :: index_sequence <indices...>) const;
+
+public:
+
+  // Operators
+
+  typename std :: tuple_element <0, std :: tuple <types...>> :: type * operator [] (const size_t &);
+  const typename std :: tuple_element <0, std :: tuple <types...>> :: type * operator [] (const size_t &) const;
+
+private:
+
+  // Private static methods
+
+  template <size_t... indices> static void release(const std :: tuple <types * ...> &, std :: index_sequence <indices...>);
+};
+
+#endif
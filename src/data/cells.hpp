@@ -0,0 +1,201 @@
+#ifndef __nobb__data__cells__hpp
+#define __nobb__data__cells__hpp
+
+#include "cells.h"
+
+// Constructors
+
+template <typename... types> cells <types...> :: cells() : _ranges(nullptr), _cells(0), _alloc(0), _end(0)
+{
+  this->_items = std :: tuple <types * ...> (static_cast <types *> (nullptr)...);
+}
+
+template <typename... types> cells <types...> :: cells(const size_t & count) : cells()
+{
+  this->reset(count);
+}
+
+// Destructor
+
+template <typename... types> cells <types...> :: ~cells()
+{
+  release(this->_items, columns());
+  delete [] this->_ranges;
+}
+
+// Getters
+
+template <typename... types> const size_t & cells <types...> :: size(const size_t & cell) const
+{
+  return this->_ranges[cell].size;
+}
+
+// Methods
+
+template <typename... types> size_t cells <types...> :: add(const size_t & cell, const types & ... items)
+{
+  if(this->_ranges[cell].size == this->_ranges[cell].alloc)
+    this->grow(cell);
+
+  range & range = this->_ranges[cell];
+  this->store(range.offset + range.size, columns(), items...);
+
+  return range.size++;
+}
+
+template <typename... types> void cells <types...> :: remove(const size_t & cell, const size_t & index)
+{
+  // Swap with last: the last element of the cell (if any) moves to index
+
+  range & range = this->_ranges[cell];
+  this->move(this->_items, range.offset + range.size - 1, range.offset + index, columns());
+  range.size--;
+}
+
+template <typename... types> void cells <types...> :: reset(const size_t & count)
+{
+  release(this->_items, columns());
+  delete [] this->_ranges;
+
+  this->_cells = count;
+  this->_alloc = count * first_alloc;
+  this->_end = this->_alloc;
+
+  this->allocate();
+  this->_ranges = new range [this->_cells];
+
+  for(size_t i = 0; i < this->_cells; i++)
+  {
+    this->_ranges[i].offset = i * first_alloc;
+    this->_ranges[i].size = 0;
+    this->_ranges[i].alloc = first_alloc;
+  }
+}
+
+template <typename... types> template <typename lambda> void cells <types...> :: each(const size_t & cell, const lambda & callback)
+{
+  // Items are re-read at every step: the callback is allowed to move other items across the grid
+
+  for(size_t i = 0; i < this->_ranges[cell].size; i++)
+    this->call(this->_ranges[cell].offset + i, callback, columns());
+}
+
+template <typename... types> template <typename lambda> void cells <types...> :: each(const size_t & cell, const lambda & callback) const
+{
+  for(size_t i = 0; i < this->_ranges[cell].size; i++)
+    this->call(this->_ranges[cell].offset + i, callback, columns());
+}
+
+template <typename... types> template <size_t column> typename std :: tuple_element <column, std :: tuple <types...>> :: type * cells <types...> :: get(const size_t & cell)
+{
+  return std :: get <column> (this->_items) + this->_ranges[cell].offset;
+}
+
+template <typename... types> template <size_t column> const typename std :: tuple_element <column, std :: tuple <types...>> :: type * cells <types...> :: get(const size_t & cell) const
+{
+  return std :: get <column> (this->_items) + this->_ranges[cell].offset;
+}
+
+// Private methods
+
+template <typename... types> void cells <types...> :: grow(const size_t & full)
+{
+  // The full cell moves to the end of the arrays with twice its room, leaving a hole behind
+
+  range & range = this->_ranges[full];
+
+  if(this->_end + 2 * range.alloc > this->_alloc)
+  {
+    this->relayout(full);
+    return;
+  }
+
+  for(size_t i = 0; i < range.size; i++)
+    this->move(this->_items, range.offset + i, this->_end + i, columns());
+
+  range.offset = this->_end;
+  range.alloc *= 2;
+
+  this->_end += range.alloc;
+}
+
+template <typename... types> void cells <types...> :: relayout(const size_t & full)
+{
+  // The full cell doubles its room, every other cell keeps its own: cells are compacted back in order, leaving as much free room at the end
+
+  this->_ranges[full].alloc *= 2;
+
+  size_t used = 0;
+
+  for(size_t i = 0; i < this->_cells; i++)
+    used += this->_ranges[i].alloc;
+
+  std :: tuple <types * ...> old = this->_items;
+
+  this->_alloc = 2 * used;
+  this->allocate();
+
+  size_t offset = 0;
+
+  for(size_t i = 0; i < this->_cells; i++)
+  {
+    for(size_t j = 0; j < this->_ranges[i].size; j++)
+      this->move(old, this->_ranges[i].offset + j, offset + j, columns());
+
+    this->_ranges[i].offset = offset;
+    offset += this->_ranges[i].alloc;
+  }
+
+  this->_end = used;
+
+  release(old, columns());
+}
+
+template <typename... types> void cells <types...> :: allocate()
+{
+  this->_items = std :: tuple <types * ...> (new types [this->_alloc]...);
+}
+
+template <typename... types> template <size_t... indices> void cells <types...> :: store(const size_t & index, std :: index_sequence <indices...>, const types & ... items)
+{
+  int expand[] = {0, (std :: get <indices> (this->_items)[index] = items, 0)...};
+  (void) expand;
+}
+
+template <typename... types> template <size_t... indices> void cells <types...> :: move(const std :: tuple <types * ...> & source, const size_t & from, const size_t & to, std :: index_sequence <indices...>)
+{
+  int expand[] = {0, (std :: get <indices> (this->_items)[to] = std :: get <indices> (source)[from], 0)...};
+  (void) expand;
+}
+
+template <typename... types> template <typename lambda, size_t... indices> void cells <types...> :: call(const size_t & index, const lambda & callback, std :: index_sequence <indices...>)
+{
+  callback(std :: get <indices> (this->_items)[index]...);
+}
+
+template <typename... types> template <typename lambda, size_t... indices> void cells <types...> :: call(const size_t & index, const lambda & callback, std :: index_sequence <indices...>) const
+{
+  callback(static_cast <const types &> (std :: get <indices> (this->_items)[index])...);
+}
+
+// Operators
+
+template <typename... types> typename std :: tuple_element <0, std :: tuple <types...>> :: type * cells <types...> :: operator [] (const size_t & cell)
+{
+  return this->template get <0> (cell);
+}
+
+template <typename... types> const typename std :: tuple_element <0, std :: tuple <types...>> :: type * cells <types...> :: operator [] (const size_t & cell) const
+{
+  return this->template get <0> (cell);
+}
+
+// Private static methods
+
+template <typename... types> template <size_t... indices> void cells <types...> :: release(const std :: tuple <types * ...> & items, std :: index_sequence <indices...>)
+{
+  int expand[] = {0, (delete [] std :: get <indices> (items), 0)...};
+  (void) expand;
+}
+
+#endif
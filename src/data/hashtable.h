@@ -47,10 +47,16 @@ public:
 
   ~hashtable();
 
+  // Getters
+
+  const size_t & size() const;
+
   // Methods
 
   void add(const ktype &, const vtype &);
   void remove(const ktype &);
+  void replace(const ktype &, const vtype &);
+  void reserve(const size_t &);
 
   template <typename lambda> void each(const lambda &) const;
 
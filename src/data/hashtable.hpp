@@ -18,6 +18,13 @@ template <typename ktype, typename vtype> hashtable <ktype, vtype> :: ~hashtable
   delete [] this->_items;
 }
 
+// Getters
+
+template <typename ktype, typename vtype> const size_t & hashtable <ktype, vtype> :: size() const
+{
+  return this->_size;
+}
+
 // Methods
 
 template <typename ktype, typename vtype> void hashtable <ktype, vtype> :: add(const ktype & key, const vtype & value)
@@ -74,6 +81,22 @@ template <typename ktype, typename vtype> void hashtable <ktype, vtype> :: remov
   }
 }
 
+template <typename ktype, typename vtype> void hashtable <ktype, vtype> :: replace(const ktype & key, const vtype & value)
+{
+  this->_items[this->slot(key)].value = value;
+}
+
+template <typename ktype, typename vtype> void hashtable <ktype, vtype> :: reserve(const size_t & count)
+{
+  size_t alloc = this->_alloc;
+
+  while(alloc / (this->_size + count) < expand_threshold)
+    alloc *= 2;
+
+  if(alloc != this->_alloc)
+    this->realloc(alloc);
+}
+
 template <typename ktype, typename vtype> template <typename lambda> void hashtable <ktype, vtype> :: each(const lambda & callback) const
 {
   for(size_t i = 0; i < this->_alloc; i++)
@@ -0,0 +1,88 @@
+// Forward declarations
+
+template <typename> class slotmap;
+
+#if !defined(__forward__) && !defined(__nobb__data__slotmap__h)
+#define __nobb__data__slotmap__h
+
+// Libraries
+
+#include <stdint.h>
+#include <stddef.h>
+#include <assert.h>
+
+template <typename type> class slotmap
+{
+public:
+
+  // Settings
+
+  static constexpr size_t min_alloc = 32;
+  static constexpr size_t shift = 32; // Low bits of a handle: slot, high bits: generation of the slot
+  static constexpr size_t mask = (((size_t) 1) << shift) - 1;
+
+  // Service nested classes
+
+  struct slot
+  {
+    size_t index; // Position in the dense arrays, or next free slot when the slot is free
+    size_t generation;
+  };
+
+private:
+
+  // Members
+
+  type * _items;
+  size_t * _handles; // Handle of each item, to find its slot when it is moved
+  size_t _size;
+  size_t _alloc;
+
+  slot * _slots;
+  size_t _used; // Slots handed out so far, slot 0 excluded
+  size_t _capacity;
+  size_t _free; // Most recently freed slot (0 if none)
+
+public:
+
+  // Constructors
+
+  slotmap();
+
+  // Destructor
+
+  ~slotmap();
+
+  // Getters
+
+  const size_t & size() const;
+
+  // Methods
+
+  size_t add(const type &);
+  void remove(const size_t &);
+  void replace(const size_t &, const type &);
+  void reserve(const size_t &);
+  bool has(const size_t &) const;
+
+  template <typename lambda> void each(const lambda &) const;
+
+private:
+
+  // Private methods
+
+  const slot & find(const size_t &) const;
+  void realloc(const size_t &);
+
+public:
+
+  // Operators
+
+  const type & operator [] (const size_t &) const;
+
+  // Static methods
+
+  static size_t index(const size_t &);
+};
+
+#endif
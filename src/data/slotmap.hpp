@@ -0,0 +1,168 @@
+#ifndef __nobb__data__slotmap__hpp
+#define __nobb__data__slotmap__hpp
+
+#include "slotmap.h"
+
+// Constructors
+
+template <typename type> slotmap <type> :: slotmap() : _items(new type[min_alloc]), _handles(new size_t[min_alloc]), _size(0), _alloc(min_alloc), _slots(new slot[min_alloc]), _used(0), _capacity(min_alloc), _free(0)
+{
+  static_assert(sizeof(size_t) * 8 > shift, "Handles need more bits than a slot index.");
+}
+
+// Destructor
+
+template <typename type> slotmap <type> :: ~slotmap()
+{
+  delete [] this->_items;
+  delete [] this->_handles;
+  delete [] this->_slots;
+}
+
+// Getters
+
+template <typename type> const size_t & slotmap <type> :: size() const
+{
+  return this->_size;
+}
+
+// Methods
+
+template <typename type> size_t slotmap <type> :: add(const type & item)
+{
+  if(this->_size == this->_alloc)
+    this->realloc(this->_alloc * 2);
+
+  // Freed slots are reused first, slot 0 is never handed out so that no handle is 0
+
+  size_t index;
+
+  if(this->_free)
+  {
+    index = this->_free;
+    this->_free = this->_slots[index].index;
+  }
+  else
+  {
+    if(this->_used + 1 == this->_capacity)
+    {
+      slot * old = this->_slots;
+
+      this->_capacity *= 2;
+      this->_slots = new slot[this->_capacity];
+
+      for(size_t i = 0; i <= this->_used; i++)
+        this->_slots[i] = old[i];
+
+      delete [] old;
+    }
+
+    index = ++(this->_used);
+    this->_slots[index].generation = 0;
+  }
+
+  size_t handle = index | (this->_slots[index].generation << shift);
+
+  this->_slots[index].index = this->_size;
+  this->_items[this->_size] = item;
+  this->_handles[this->_size] = handle;
+  this->_size++;
+
+  return handle;
+}
+
+template <typename type> void slotmap <type> :: remove(const size_t & handle)
+{
+  size_t index = slotmap :: index(handle);
+  size_t position = this->find(handle).index;
+
+  // Swap with last: the last item (if any) moves to the position of the removed one
+
+  this->_size--;
+
+  this->_items[position] = this->_items[this->_size];
+  this->_handles[position] = this->_handles[this->_size];
+  this->_slots[slotmap :: index(this->_handles[position])].index = position;
+
+  // A new generation makes every handle to the slot stale
+
+  this->_slots[index].generation = (this->_slots[index].generation + 1) & (SIZE_MAX >> shift);
+  this->_slots[index].index = this->_free;
+  this->_free = index;
+}
+
+template <typename type> void slotmap <type> :: replace(const size_t & handle, const type & item)
+{
+  this->_items[this->find(handle).index] = item;
+}
+
+template <typename type> void slotmap <type> :: reserve(const size_t & count)
+{
+  size_t alloc = this->_alloc;
+
+  while(alloc < this->_size + count)
+    alloc *= 2;
+
+  if(alloc != this->_alloc)
+    this->realloc(alloc);
+}
+
+template <typename type> bool slotmap <type> :: has(const size_t & handle) const
+{
+  size_t index = slotmap :: index(handle);
+
+  if(!index || index > this->_used || this->_slots[index].generation != (handle >> shift))
+    return false;
+
+  size_t position = this->_slots[index].index;
+  return position < this->_size && this->_handles[position] == handle; // Free slots hold a link to the next free slot instead
+}
+
+template <typename type> template <typename lambda> void slotmap <type> :: each(const lambda & callback) const
+{
+  for(size_t i = 0; i < this->_size; i++)
+    callback(this->_items[i]);
+}
+
+// Private methods
+
+template <typename type> const typename slotmap <type> :: slot & slotmap <type> :: find(const size_t & handle) const
+{
+  assert(this->has(handle));
+  return this->_slots[slotmap :: index(handle)];
+}
+
+template <typename type> void slotmap <type> :: realloc(const size_t & alloc)
+{
+  type * items = new type[alloc];
+  size_t * handles = new size_t[alloc];
+
+  for(size_t i = 0; i < this->_size; i++)
+  {
+    items[i] = this->_items[i];
+    handles[i] = this->_handles[i];
+  }
+
+  delete [] this->_items;
+  delete [] this->_handles;
+
+  this->_items = items;
+  this->_handles = handles;
+  this->_alloc = alloc;
+}
+
+// Operators
+
+template <typename type> const type & slotmap <type> :: operator [] (const size_t & handle) const
+{
+  return this->_items[this->find(handle).index];
+}
+
+// Static methods
+
+template <typename type> size_t slotmap <type> :: index(const size_t & handle)
+{
+  return handle & mask;
+}
+
+#endif
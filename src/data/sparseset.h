@@ -0,0 +1,62 @@
+// Forward declarations
+
+template <typename> class sparseset;
+
+#if !defined(__forward__) && !defined(__nobb__data__sparseset__h)
+#define __nobb__data__sparseset__h
+
+// Libraries
+
+#include <stdint.h>
+#include <stddef.h>
+#include <assert.h>
+
+template <typename type> class sparseset
+{
+public:
+
+  // Settings
+
+  static constexpr size_t first_alloc = 16;
+
+private:
+
+  // Members
+
+  type * _items;
+  size_t * _keys; // Key of each item
+  size_t _size;
+  size_t _alloc;
+
+  size_t * _positions; // Position of the item of each key, meaningful only if the key is in the set
+  size_t _capacity;
+
+public:
+
+  // Constructors
+
+  sparseset();
+
+  // Destructor
+
+  ~sparseset();
+
+  // Getters
+
+  const size_t & size() const;
+
+  // Methods
+
+  void add(const size_t &, const type &);
+  void remove(const size_t &);
+  void replace(const size_t &, const type &);
+  bool has(const size_t &) const;
+
+  template <typename lambda> void each(const lambda &) const;
+
+  // Operators
+
+  const type & operator [] (const size_t &) const;
+};
+
+#endif
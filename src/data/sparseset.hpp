@@ -0,0 +1,120 @@
+#ifndef __nobb__data__sparseset__hpp
+#define __nobb__data__sparseset__hpp
+
+#include "sparseset.h"
+
+// Constructors
+
+template <typename type> sparseset <type> :: sparseset() : _items(nullptr), _keys(nullptr), _size(0), _alloc(0), _positions(nullptr), _capacity(0)
+{
+}
+
+// Destructor
+
+template <typename type> sparseset <type> :: ~sparseset()
+{
+  delete [] this->_items;
+  delete [] this->_keys;
+  delete [] this->_positions;
+}
+
+// Getters
+
+template <typename type> const size_t & sparseset <type> :: size() const
+{
+  return this->_size;
+}
+
+// Methods
+
+template <typename type> void sparseset <type> :: add(const size_t & key, const type & item)
+{
+  assert(!(this->has(key)));
+
+  // Nothing is allocated until the first item is added
+
+  if(this->_size == this->_alloc)
+  {
+    size_t alloc = this->_alloc ? 2 * this->_alloc : first_alloc;
+
+    type * items = new type [alloc];
+    size_t * keys = new size_t [alloc];
+
+    for(size_t i = 0; i < this->_size; i++)
+    {
+      items[i] = this->_items[i];
+      keys[i] = this->_keys[i];
+    }
+
+    delete [] this->_items;
+    delete [] this->_keys;
+
+    this->_items = items;
+    this->_keys = keys;
+    this->_alloc = alloc;
+  }
+
+  if(key >= this->_capacity)
+  {
+    size_t capacity = this->_capacity ? this->_capacity : first_alloc;
+
+    while(capacity <= key)
+      capacity *= 2;
+
+    size_t * positions = new size_t [capacity]();
+
+    for(size_t i = 0; i < this->_capacity; i++)
+      positions[i] = this->_positions[i];
+
+    delete [] this->_positions;
+
+    this->_positions = positions;
+    this->_capacity = capacity;
+  }
+
+  this->_positions[key] = this->_size;
+  this->_items[this->_size] = item;
+  this->_keys[this->_size] = key;
+  this->_size++;
+}
+
+template <typename type> void sparseset <type> :: remove(const size_t & key)
+{
+  assert(this->has(key));
+
+  // Swap with last: the last item (if any) moves to the position of the removed one
+
+  size_t position = this->_positions[key];
+  this->_size--;
+
+  this->_items[position] = this->_items[this->_size];
+  this->_keys[position] = this->_keys[this->_size];
+  this->_positions[this->_keys[position]] = position;
+}
+
+template <typename type> void sparseset <type> :: replace(const size_t & key, const type & item)
+{
+  assert(this->has(key));
+  this->_items[this->_positions[key]] = item;
+}
+
+template <typename type> bool sparseset <type> :: has(const size_t & key) const
+{
+  return key < this->_capacity && this->_positions[key] < this->_size && this->_keys[this->_positions[key]] == key;
+}
+
+template <typename type> template <typename lambda> void sparseset <type> :: each(const lambda & callback) const
+{
+  for(size_t i = 0; i < this->_size; i++)
+    callback(this->_items[i]);
+}
+
+// Operators
+
+template <typename type> const type & sparseset <type> :: operator [] (const size_t & key) const
+{
+  assert(this->has(key));
+  return this->_items[this->_positions[key]];
+}
+
+#endif
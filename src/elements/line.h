@@ -3,7 +3,7 @@
 class xline;
 
 #if !defined(__forward__) && !defined (__nobb__elements__xline__h)
-#define __nobb__elements__bumper__h
+#define __nobb__elements__xline__h
 
 // Libraries
 
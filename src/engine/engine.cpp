@@ -3,21 +3,35 @@
 #include "event/events/bumper.h"
 #include "event/events/line.h"
 #include "event/events/grid.h"
+#include "event/events/sample.h"
 
 // tag
 
 // Constructors
 
-engine :: tag :: tag() : _id(autoincrement++), _references(0)
+engine :: tag :: tag() : _id(0), _references(0), _material(0), _impact(-std :: numeric_limits <double> :: infinity()), _burst(0)
 {
-  memset(this->_tags, '\0', tags);
+  memset(this->_mask, '\0', sizeof(this->_mask));
 }
 
 // Destructor
 
 engine :: ~engine()
 {
+  // Pending events release the removed molecules they still point to
+
+  while(this->_events.size())
+    this->discard(this->_events.pop());
+
+  this->_molecules.each([&](molecule * molecule)
+  {
+    this->destroy(molecule);
+  });
+
+  :: operator delete(this->_storage.block);
+
   delete [] this->_tags;
+  delete this->_schedule.sampler;
 }
 
 // Getters
@@ -29,11 +43,12 @@ const size_t & engine :: tag :: id() const
 
 size_t engine :: tag :: size() const
 {
-  for(size_t i = 0; i < tags; i++)
-    if(!(this->_tags[i]))
-      return i;
+  size_t size = 0;
 
-  return tags;
+  for(size_t word = 0; word < words; word++)
+    size += count(this->_mask[word]);
+
+  return size;
 }
 
 const size_t & engine :: tag :: references() const
@@ -41,40 +56,55 @@ const size_t & engine :: tag :: references() const
   return this->_references;
 }
 
+const uint16_t & engine :: tag :: material() const
+{
+  return this->_material;
+}
+
+bool engine :: tag :: has(const uint8_t & tag) const
+{
+  return (this->_mask[tag / 64] >> (tag % 64)) & 1;
+}
+
 // Private methods
 
 void engine :: tag :: add(const uint8_t & tag)
 {
-  for(size_t i = 0; i < tags; i++)
-    if(!(this->_tags[i]))
-    {
-      this->_tags[i] = tag + 1;
-      return;
-    }
+  this->_mask[tag / 64] |= ((uint64_t) 1) << (tag % 64);
 }
 
 void engine :: tag :: remove(const uint8_t & tag)
 {
-  bool shift = false;
+  this->_mask[tag / 64] &= ~(((uint64_t) 1) << (tag % 64));
+}
 
-  for(size_t i = 0; i < tags; i++)
+// Operators
+
+uint8_t engine :: tag :: operator [] (const size_t & index) const
+{
+  // Tags are sorted: the index-th one is the index-th set bit
+
+  size_t skip = index;
+
+  for(size_t word = 0; word < words; word++)
   {
-    if(this->_tags[i] == tag + 1)
+    size_t bits = count(this->_mask[word]);
+
+    if(skip < bits)
     {
-      this->_tags[i] = 0;
-      shift = true;
+      uint64_t mask = this->_mask[word];
+
+      for(size_t i = 0; i < skip; i++)
+        mask &= mask - 1;
+
+      return (uint8_t) (64 * word + lowest(mask));
     }
 
-    if(shift && i < tags - 1)
-      this->_tags[i] = this->_tags[i + 1];
+    skip -= bits;
   }
-}
 
-// Operators
-
-uint8_t engine :: tag :: operator [] (const size_t & index) const
-{
-  return this->_tags[index] - 1;
+  assert(false && "Tag index out of range.");
+  return 0;
 }
 
 // Private operators
@@ -99,25 +129,77 @@ void engine :: tag :: operator -- (int)
   --(*this);
 }
 
-// Private static members
+// Private static methods
 
-size_t engine :: tag :: autoincrement = 1;
+size_t engine :: tag :: count(const uint64_t & mask)
+{
+#ifdef _MSC_VER
+  return (size_t) __popcnt64(mask);
+#else
+  return (size_t) __builtin_popcountll(mask);
+#endif
+}
+
+size_t engine :: tag :: lowest(const uint64_t & mask)
+{
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanForward64(&index, mask);
+  return (size_t) index;
+#else
+  return (size_t) __builtin_ctzll(mask);
+#endif
+}
 
 // engine
 
 // Constructors
 
-engine :: engine(const size_t & fineness) : _grid(fineness), _tags(new hashtable <size_t, molecule *> [256]), _time(0), reset(*this)
+engine :: engine() : engine(1, 1)
 {
-  this->_elasticity.all = 1.;
+  this->_regrid.automatic = true;
+}
 
-  for(size_t i = 0; i < 255; i++)
-  {
-    this->_elasticity.stag[i] = -1;
+engine :: engine(const size_t & fineness) : engine(fineness, fineness)
+{
+}
 
-    for(size_t j = 0; j < 255; j++)
-      this->_elasticity.dtag[i][j] = -1;
-  }
+engine :: engine(const size_t & xfineness, const size_t & yfineness) : _grid(xfineness, yfineness), _tags(new sparseset <molecule *> [256]), _time(0), reset(*this)
+{
+  this->_elasticity.all = 1.;
+
+  for(size_t i = 0; i < 256; i++)
+    this->_elasticity.classes[i] = generic;
+
+  this->_elasticity.size = 2;
+  this->_elasticity.single.assign(2, -1);
+  this->_elasticity.pair.assign(4, -1);
+  this->tabulate();
+
+  this->_collapse.tc = 0;
+  this->_collapse.interval = 0;
+  this->_collapse.burst = 0;
+  this->_collapse.stalled = false;
+  this->_collapse.time = 0;
+
+  this->_schedule.sampler = nullptr;
+  this->_schedule.version = 0;
+
+  this->_regrid.automatic = false;
+  this->_regrid.molecules = 0;
+  this->_regrid.radius = 0;
+  this->_regrid.smallest = std :: numeric_limits <double> :: infinity();
+  this->_regrid.bumper = 0;
+  this->_regrid.crossings = 0;
+  this->_regrid.collisions = 0;
+  this->_regrid.reference = 0;
+  this->_regrid.pending = false;
+  this->_regrid.fineness = 0;
+  this->_regrid.levels = 0;
+
+  this->_storage.block = nullptr;
+  this->_storage.size = 0;
+  this->_storage.events = 0;
 }
 
 // Getters
@@ -127,61 +209,93 @@ const size_t & engine :: fineness() const
   return this->_grid.fineness();
 }
 
+const size_t & engine :: xfineness() const
+{
+  return this->_grid.xfineness();
+}
+
+const size_t & engine :: yfineness() const
+{
+  return this->_grid.yfineness();
+}
+
+const size_t & engine :: levels() const
+{
+  return this->_grid.levels();
+}
+
 const size_t & engine :: event_heap_size() const
 {
   return this->_events.size();
 }
 
+const size_t & engine :: molecule_count() const
+{
+  return this->_molecules.size();
+}
+
+const std :: vector <size_t> & engine :: collapsed() const
+{
+  return this->_collapse.molecules;
+}
+
+const double & engine :: time() const
+{
+  return this->_time;
+}
+
 // Setters
 
 void engine :: elasticity(const double & elasticity)
 {
   assert(elasticity > 0);
   this->_elasticity.all = elasticity;
-
-  this->_molecules.each([&](molecule * molecule)
-  {
-    this->refresh(*molecule);
-  });
+  this->tabulate();
 }
 
 void engine :: elasticity(const uint8_t & tag, const double & elasticity)
 {
   assert(elasticity > 0);
-  this->_elasticity.stag[tag] = elasticity;
-
-  this->_molecules.each([&](molecule * molecule)
-  {
-    this->refresh(*molecule);
-  });
+  this->_elasticity.single[this->material(tag)] = elasticity;
+  this->tabulate();
 }
 
 void engine :: elasticity(const uint8_t & alpha, const uint8_t & beta, const double & elasticity)
 {
   assert(elasticity > 0);
-  this->_elasticity.dtag[alpha][beta] = elasticity;
-  this->_elasticity.dtag[beta][alpha] = elasticity;
 
-  this->_molecules.each([&](molecule * molecule)
-  {
-    this->refresh(*molecule);
-  });
+  uint16_t first = this->material(alpha);
+  uint16_t second = this->material(beta);
+
+  this->_elasticity.pair[first * this->_elasticity.size + second] = elasticity;
+  this->_elasticity.pair[second * this->_elasticity.size + first] = elasticity;
+  this->tabulate();
+}
+
+void engine :: collapse(const double & tc)
+{
+  assert(tc >= 0);
+  this->_collapse.tc = tc;
+}
+
+void engine :: watchdog(const double & interval, const size_t & burst)
+{
+  assert(interval >= 0);
+
+  this->_collapse.interval = interval;
+  this->_collapse.burst = burst;
 }
 
 // Methods
 
 size_t engine :: add(const molecule & molecule)
 {
-  class molecule * entry = new class molecule(molecule);
-  
-  entry->set_time(this->_time);
-  
-  this->_molecules.add(entry->tag.id(), entry);
-
-  this->_grid.add(*entry);
-  this->refresh(*entry);
+  return this->insert(new class molecule(molecule));
+}
 
-  return entry->tag.id();
+size_t engine :: add(const molecule & prototype, const vec & position, const vec & velocity, const double & orientation, const double & angular_velocity)
+{
+  return this->insert(new molecule(prototype, position, velocity, orientation, angular_velocity));
 }
 
 void engine :: add(const bumper & bumper)
@@ -189,19 +303,23 @@ void engine :: add(const bumper & bumper)
   class bumper * entry = new class bumper(bumper);
   this->_bumpers.add(entry);
 
+  this->_regrid.bumper = std :: max(this->_regrid.bumper, bumper.radius());
+
+  if(this->_regrid.automatic && this->_grid.xfineness() > this->limit())
+  {
+    this->regrid();
+    return;
+  }
+
   this->_grid.add(*entry);
 
-  for(ssize_t dx = -1; dx <= 1; dx++)
-    for(ssize_t dy = -1; dy <= 1; dy++)
+  this->_grid.around(entry->mark, [&](const size_t & level, const size_t & x, const size_t & y, const int &)
+  {
+    this->_grid.each <class molecule> (level, x, y, [&](class molecule & molecule)
     {
-      ssize_t x = (bumper.mark.x() + this->_grid.fineness() + dx) % this->_grid.fineness();
-      ssize_t y = (bumper.mark.y() + this->_grid.fineness() + dy) % this->_grid.fineness();
-
-      this->_grid.each <class molecule> (x, y, [&](class molecule & molecule)
-      {
-        this->refresh(molecule);
-      });
-    }
+      this->refresh(molecule);
+    });
+  });
 }
 
 void engine :: add(const xline & xline)
@@ -211,108 +329,489 @@ void engine :: add(const xline & xline)
 
   this->_grid.add(*entry);
 
-  for(ssize_t dx = -1; dx <= 1; dx++)
-    for(size_t y = 0; y < this->_grid.fineness(); y++) // xlines stay in y = 0 sectors
-    {
-      ssize_t x = (xline.mark.x() + this->_grid.fineness() + dx) % this->_grid.fineness();
+  for(size_t level = 0; level < this->_grid.levels(); level++)
+  {
+    const size_t & xfineness = this->_grid.xfineness(level);
+    size_t column = (size_t) (entry->xposition() * xfineness);
 
-      this->_grid.each <class molecule> (x, y, [&](class molecule & molecule)
+    for(ssize_t dx = -1; dx <= 1; dx++)
+      for(size_t y = 0; y < this->_grid.yfineness(level); y++) // xlines span whole columns
       {
-        this->refresh(molecule);
-      });
-    }
+        ssize_t x = (column + xfineness + dx) % xfineness;
+
+        this->_grid.each <class molecule> (level, x, y, [&](class molecule & molecule)
+        {
+          this->refresh(molecule);
+        });
+      }
+  }
 }
 
 
-void engine :: remove(const size_t & id)
+bool engine :: remove(const size_t & id)
 {
+  // Stale ids (their molecule was removed, their slot maybe reused) are rejected: asserts are off in release builds
+
+  if(!(this->_molecules.has(id)))
+    return false;
+
   molecule * entry = this->_molecules[id];
   this->_grid.remove(*entry);
   entry->disable();
 
+  entry->tag.each([&](const uint8_t & tag)
+  {
+    this->_tags[tag].remove(slotmap <molecule *> :: index(id));
+  });
+
   this->_molecules.remove(id);
-  this->_garbage.add(entry);
+
+  // Pending events still point to the molecule: the last one to be discarded destroys it
+
+  if(!(entry->tag.references()))
+    this->destroy(entry);
+
+  return true;
 }
 
-void engine :: tag(const size_t & id, const uint8_t & tag)
+void engine :: reserve(const size_t & count)
 {
+  this->_molecules.reserve(count);
+}
+
+bool engine :: tag(const size_t & id, const uint8_t & tag)
+{
+  if(!(this->_molecules.has(id)))
+    return false;
+
   molecule * entry = this->_molecules[id];
+
+  if(entry->tag.has(tag))
+    return true;
+
   entry->tag.add(tag);
-  this->_tags[tag].add(id, entry);
+  this->_tags[tag].add(slotmap <molecule *> :: index(id), entry);
+
+  this->classify(*entry);
+  return true;
 }
 
-void engine :: untag(const size_t & id, const uint8_t & tag)
+bool engine :: untag(const size_t & id, const uint8_t & tag)
 {
+  if(!(this->_molecules.has(id)))
+    return false;
+
   molecule * entry = this->_molecules[id];
+
+  if(!(entry->tag.has(tag)))
+    return true;
+
   entry->tag.remove(tag);
-  this->_tags[tag].remove(id);
+  this->_tags[tag].remove(slotmap <molecule *> :: index(id));
+
+  this->classify(*entry);
+  return true;
 }
 
-void engine :: run(const double & time)
+void engine :: unschedule()
 {
-  begin = std::chrono::steady_clock::now();
-  end = std::chrono::steady_clock::now();
-  mid = std::chrono::steady_clock::now();
-  double ETA;
-  double starting_time = this->_time;
-  unsigned int mins, hours, secs;
+  delete this->_schedule.sampler;
 
-  while(this->_events.size() && ((const event *) (this->_events.peek()))->time() <= time)
-  {
-    if (std::chrono::duration_cast<std::chrono::seconds>(end - mid).count() > 10)
-    {
-      mid = std::chrono::steady_clock::now();
-      ETA = std::chrono::duration_cast<std::chrono::seconds>(mid - begin).count() * (time - ((const event *)(this->_events.peek()))->time()) / (((const event *)(this->_events.peek()))->time() - starting_time);
-      secs = fmod(ETA, 60);
-      mins = int(ETA / 60) % 60;
-      hours = mins / 60;
-      std::cout << "(" << starting_time << " -> " << ((const event *)(this->_events.peek()))->time() << " -> " << time << ") "
-                << "ETA: " << hours << "h" << mins << "m" << secs << "s" << std::endl;
-    }
+  this->_schedule.sampler = nullptr;
+  this->_schedule.times.clear();
+  this->_schedule.version++; // Pending sample events become stale
+}
 
+void engine :: regrid()
+{
+  size_t fineness = std :: min(this->limit(), std :: max <size_t> (1, (size_t) round(sqrt(this->_molecules.size() / occupancy))));
+  size_t levels = this->levels(fineness);
+
+  this->_regrid.automatic = true;
+  this->_regrid.molecules = this->_molecules.size();
+  this->_regrid.crossings = 0;
+  this->_regrid.collisions = 0;
+  this->_regrid.reference = 0;
+
+  if(fineness != this->_grid.xfineness() || fineness != this->_grid.yfineness() || levels != this->_grid.levels())
+    this->rebuild(fineness, fineness, levels);
+}
+
+void engine :: regrid(const size_t & fineness)
+{
+  this->regrid(fineness, fineness);
+}
+
+void engine :: regrid(const size_t & xfineness, const size_t & yfineness)
+{
+  this->regrid(xfineness, yfineness, 1);
+}
+
+void engine :: regrid(const size_t & xfineness, const size_t & yfineness, const size_t & levels)
+{
+  this->_regrid.automatic = false;
+  this->rebuild(xfineness, yfineness, levels);
+}
+
+void engine :: reorder()
+{
+  this->rebuild(this->_grid.xfineness(), this->_grid.yfineness(), this->_grid.levels());
+}
+
+bool engine :: run(const double & time)
+{
+  this->loop(time, this->_dispatcher);
+  return !(this->_collapse.stalled);
+}
+
+stream engine :: events_until(const double & time)
+{
+  this->_collapse.stalled = false;
+  return stream(*this, time);
+}
+
+// Private methods
+
+event * engine :: next(const double & time)
+{
+  // The stream is done with the event returned by the previous call: molecules can be moved
+
+  if(this->_regrid.automatic && this->_regrid.molecules != this->_molecules.size())
+    this->regrid();
+
+  this->resize();
+
+  if(this->_storage.events > period * this->_molecules.size())
+    this->reorder();
+
+  while(!(this->_collapse.stalled) && this->_events.size() && ((const event *) (this->_events.peek()))->time() <= time)
+  {
     event * event = this->_events.pop();
-    event->each(this, &engine :: decref);
+    this->_storage.events++;
 
     if(event->resolve())
     {
+      event->each(this, &engine :: sync);
       event->each(this, &engine :: refresh);
-      event->callback(this->_dispatcher);
+      this->_dispatcher.trigger(event);
+
+      if(this->_regrid.automatic)
+        this->account(event);
+
+      if(event->type() == event :: molecule_kind)
+        event->each(this, &engine :: inspect); // A flagged molecule ends the stream once this event is handed out
+
+      if(event->type() != event :: grid_kind && event->type() != event :: sample_kind)
+        return event; // Discarded by the stream once it is done with it
     }
 
-    delete event;
-    end = std::chrono::steady_clock::now();
+    this->discard(event);
+    this->resize();
   }
 
-  if(time > this->_time)
-    this->_time = time;
+  return nullptr;
+}
+
+void engine :: settle(const double & time)
+{
+  // A run stopped by the watchdog is left at the time of the collision that flagged the collapse
+
+  double target = this->_collapse.stalled ? std :: min(time, this->_collapse.time) : time;
+
+  if(target > this->_time)
+    this->_time = target;
 
   this->_molecules.each([&](molecule *molecule) {
     molecule->integrate(this->_time);
     this->check_position(*molecule);
   });
+}
 
-  this->collect();
+double engine :: elasticity(const molecule & alpha, const molecule & beta) const
+{
+  return this->_elasticity.matrix[alpha.tag.material() * this->_elasticity.size + beta.tag.material()];
 }
 
-// Private methods
+double engine :: restitution(molecule & alpha, molecule & beta, const double & time) const
+{
+  // TC model: a molecule that collided less than tc ago is still in a cluster that would otherwise collapse, and collides elastically
+
+  bool elastic = (time - alpha.tag._impact < this->_collapse.tc) || (time - beta.tag._impact < this->_collapse.tc);
+
+  for(molecule * molecule : {&alpha, &beta})
+  {
+    molecule->tag._burst = (time - molecule->tag._impact < this->_collapse.interval) ? molecule->tag._burst + 1 : 0;
+    molecule->tag._impact = time;
+  }
+
+  return elastic ? 1. : this->elasticity(alpha, beta);
+}
+
+uint16_t engine :: material(const uint8_t & tag)
+{
+  if(this->_elasticity.classes[tag] != generic)
+    return this->_elasticity.classes[tag];
 
-double engine :: elasticity(const molecule & alpha, const molecule & beta)
+  // The tag gets its own class: settings grow by one row and column
+
+  size_t size = this->_elasticity.size;
+  std :: vector <double> pair((size + 1) * (size + 1), -1);
+
+  for(size_t i = 0; i < size; i++)
+    for(size_t j = 0; j < size; j++)
+      pair[i * (size + 1) + j] = this->_elasticity.pair[i * size + j];
+
+  this->_elasticity.pair = pair;
+  this->_elasticity.single.push_back(-1);
+  this->_elasticity.classes[tag] = size;
+  this->_elasticity.size++;
+
+  // Molecules whose only tag is this one were generic so far
+
+  this->_tags[tag].each([&](molecule * molecule)
+  {
+    this->classify(*molecule);
+  });
+
+  return size;
+}
+
+void engine :: classify(molecule & molecule)
 {
-  if(alpha.tag.size() == 1 && beta.tag.size() == 1 && this->_elasticity.dtag[alpha.tag[0]][beta.tag[0]] > 0)
-    return this->_elasticity.dtag[alpha.tag[0]][beta.tag[0]];
-  else if(alpha.tag.size() == 1 && beta.tag.size() == 0 && this->_elasticity.stag[alpha.tag[0]] > 0)
-    return this->_elasticity.stag[alpha.tag[0]];
-  else if(alpha.tag.size() == 0 && beta.tag.size() == 1 && this->_elasticity.stag[beta.tag[0]] > 0)
-    return this->_elasticity.stag[beta.tag[0]];
+  // Coefficients of a tag only apply to molecules that have no other tag
+
+  size_t size = molecule.tag.size();
+
+  if(!size)
+    molecule.tag._material = untagged;
+  else if(size == 1)
+    molecule.tag._material = this->_elasticity.classes[molecule.tag[0]];
   else
-    return this->_elasticity.all;
+    molecule.tag._material = generic;
+}
+
+void engine :: tabulate()
+{
+  // Pairs of single-tag classes take their own coefficient, a single-tag class against untagged molecules the one of its tag, anything else the global one
+
+  size_t size = this->_elasticity.size;
+  this->_elasticity.matrix.assign(size * size, this->_elasticity.all);
+
+  for(size_t i = generic + 1; i < size; i++)
+  {
+    if(this->_elasticity.single[i] > 0)
+    {
+      this->_elasticity.matrix[i * size + untagged] = this->_elasticity.single[i];
+      this->_elasticity.matrix[untagged * size + i] = this->_elasticity.single[i];
+    }
+
+    for(size_t j = generic + 1; j < size; j++)
+      if(this->_elasticity.pair[i * size + j] > 0)
+        this->_elasticity.matrix[i * size + j] = this->_elasticity.pair[i * size + j];
+  }
+}
+
+void engine :: sample(const events :: sample & event)
+{
+  // Molecules are integrated lazily by each, so moving the clock is enough
+
+  this->_time = event.time();
+  this->_schedule.sampler->trigger(event);
+
+  if(event.index() + 1 < this->_schedule.times.size())
+    this->_events.push(event :: wrapper(new events :: sample(*this, event.index() + 1)));
+}
+
+size_t engine :: insert(molecule * entry)
+{
+  size_t id = this->_molecules.add(entry);
+
+  entry->set_time(this->_time);
+  entry->tag._id = id;
+
+  this->classify(*entry);
+
+  this->_grid.add(*entry);
+  this->refresh(*entry);
+
+  this->_regrid.radius = std :: max(this->_regrid.radius, entry->radius());
+  this->_regrid.smallest = std :: min(this->_regrid.smallest, entry->radius());
+
+  // Automatic grids follow the molecule count geometrically, so that filling an engine costs amortized linear time (the regrid relocates the molecule)
+
+  if(this->_regrid.automatic && (this->_molecules.size() > 2 * this->_regrid.molecules || this->_grid.xfineness() > this->limit()))
+    this->regrid();
+
+  return id;
+}
+
+void engine :: rebuild(const size_t & xfineness, const size_t & yfineness, const size_t & levels)
+{
+  this->_regrid.pending = false;
+
+  // Drop every prediction, keeping sample events (they do not depend on the grid)
+
+  std :: vector <event *> samples;
+
+  while(this->_events.size())
+  {
+    event * event = this->_events.pop();
+
+    if(event->type() == event :: sample_kind)
+      samples.push_back(event);
+    else
+      this->discard(event);
+  }
+
+  for(event * sample : samples)
+    this->_events.push(event :: wrapper(sample));
+
+  this->relocate();
+
+  // Fill the new grid as if the elements were added again
+
+  this->_grid.reset(xfineness, yfineness, levels);
+
+  this->_bumpers.each([&](bumper * bumper)
+  {
+    this->_grid.add(*bumper);
+  });
+
+  this->_xlines.each([&](xline * xline)
+  {
+    this->_grid.add(*xline);
+  });
+
+  // Molecules were just relocated: walking them in storage order fills the regions in Morton order
+
+  for(size_t i = 0; i < this->_storage.size; i++)
+  {
+    this->_grid.add(this->_storage.block[i]);
+    this->refresh(this->_storage.block[i]);
+  }
+}
+
+void engine :: relocate()
+{
+  // No event is pending: molecules can be moved, as long as the tables that point to them follow
+
+  std :: vector <std :: pair <uint32_t, molecule *>> order;
+  order.reserve(this->_molecules.size());
+
+  this->_molecules.each([&](molecule * molecule)
+  {
+    order.push_back({morton(molecule->position()), molecule});
+  });
+
+  std :: sort(order.begin(), order.end(), [](const std :: pair <uint32_t, molecule *> & alpha, const std :: pair <uint32_t, molecule *> & beta)
+  {
+    return alpha.first < beta.first || (alpha.first == beta.first && alpha.second->tag.id() < beta.second->tag.id());
+  });
+
+  molecule * block = static_cast <molecule *> (:: operator new(order.size() * sizeof(molecule)));
+
+  for(size_t i = 0; i < order.size(); i++)
+  {
+    molecule * entry = new (block + i) molecule(*(order[i].second));
+
+    this->_molecules.replace(entry->tag.id(), entry);
+
+    entry->tag.each([&](const uint8_t & tag)
+    {
+      this->_tags[tag].replace(slotmap <molecule *> :: index(entry->tag.id()), entry);
+    });
+
+    this->destroy(order[i].second);
+  }
+
+  :: operator delete(this->_storage.block);
+
+  this->_storage.block = block;
+  this->_storage.size = order.size();
+  this->_storage.events = 0;
+}
+
+size_t engine :: limit() const
+{
+  // Regions must be at least as large as the largest interaction range, since refresh only looks at neighbouring regions
+
+  double reach = this->_regrid.radius + std :: max(this->_regrid.radius, this->_regrid.bumper);
+
+  if(!(reach > 0))
+    return std :: numeric_limits <size_t> :: max();
+
+  return std :: max <size_t> (1, (size_t) floor(1. / reach));
+}
+
+size_t engine :: levels(const size_t & fineness) const
+{
+  // Finer levels pay off when the smallest molecules fit regions much smaller than the coarsest ones, and there are enough molecules to fill them
+
+  if(!(this->_regrid.smallest > 0) || !std :: isfinite(this->_regrid.smallest))
+    return 1;
+
+  size_t target = std :: min(std :: max <size_t> (1, (size_t) floor(1. / (2. * this->_regrid.smallest))), std :: max <size_t> (1, (size_t) round(sqrt(this->_molecules.size() / occupancy))));
+
+  size_t levels = 1;
+
+  while(levels < depth && (fineness << levels) <= target)
+    levels++;
+
+  return levels;
+}
+
+void engine :: account(const event * event)
+{
+  if(event->type() == event :: grid_kind)
+    this->_regrid.crossings++;
+  else if(event->type() != event :: sample_kind)
+    this->_regrid.collisions++;
+
+  if(this->_regrid.crossings + this->_regrid.collisions < window * std :: max <size_t> (1, this->_molecules.size()))
+    return;
+
+  double ratio = (double) this->_regrid.crossings / std :: max <size_t> (1, this->_regrid.collisions);
+
+  this->_regrid.crossings = 0;
+  this->_regrid.collisions = 0;
+
+  if(!(this->_regrid.reference > 0))
+  {
+    this->_regrid.reference = ratio; // First window after a regrid: the ratio to keep
+    return;
+  }
+
+  if(ratio < this->_regrid.reference * drift && ratio > this->_regrid.reference / drift)
+    return;
+
+  // Crossings per collision grow linearly with the fineness: scale the grid back to the reference ratio
+
+  size_t fineness = std :: min(this->limit(), std :: max <size_t> (1, (size_t) round(this->_grid.xfineness() * this->_regrid.reference / std :: max(ratio, 1.e-9))));
+
+  size_t levels = this->levels(fineness);
+
+  // The event being resolved still points to its molecules, which a rebuild would move: the grid is changed by resize once it is discarded
+
+  if(fineness != this->_grid.xfineness() || fineness != this->_grid.yfineness() || levels != this->_grid.levels())
+  {
+    this->_regrid.pending = true;
+    this->_regrid.fineness = fineness;
+    this->_regrid.levels = levels;
+  }
+}
+
+void engine :: resize()
+{
+  if(this->_regrid.pending)
+    this->rebuild(this->_regrid.fineness, this->_regrid.fineness, this->_regrid.levels);
 }
 
 void engine :: check_position(molecule & molecule)
 {
   // Is the particle in the correct location? If not, fix it!
-  double step = 1. / this->_grid.fineness();
-  if (!(molecule.position().x >= step * molecule.mark.x() && molecule.position().y >= step * molecule.mark.y() && molecule.position().x <= step * (molecule.mark.x() + 1) && molecule.position().y <= step * (molecule.mark.y() + 1)))
+  double xstep = 1. / this->_grid.xfineness(molecule.mark.level());
+  double ystep = 1. / this->_grid.yfineness(molecule.mark.level());
+  if (!(molecule.position().x >= xstep * molecule.mark.x() && molecule.position().y >= ystep * molecule.mark.y() && molecule.position().x <= xstep * (molecule.mark.x() + 1) && molecule.position().y <= ystep * (molecule.mark.y() + 1)))
   {
     this->_grid.update(molecule, vec ::direct);
   }
@@ -321,6 +820,8 @@ void engine :: check_position(molecule & molecule)
 void engine :: refresh(molecule & molecule, const size_t & skip)
 {
   check_position(molecule);
+  this->_grid.sync(molecule);
+
   // Grid event
 
   events :: grid * event = new events :: grid(molecule, this->_grid);
@@ -339,6 +840,9 @@ void engine :: refresh(molecule & molecule, const size_t & skip)
   else
     delete event;
 
+  size_t level = molecule.mark.level();
+  const size_t & xfineness = this->_grid.xfineness(level);
+
   for(ssize_t dx = -1; dx <= 1; dx++)
   {
     ssize_t x = molecule.mark.x() + dx;
@@ -347,14 +851,14 @@ void engine :: refresh(molecule & molecule, const size_t & skip)
 
     if(x < 0)
       fold |= vec :: right;
-    else if(x >= static_cast<ssize_t>(this->_grid.fineness()))
+    else if(x >= static_cast<ssize_t>(xfineness))
       fold |= vec :: left;
 
-    x = (x + this->_grid.fineness()) % this->_grid.fineness();
+    x = (x + xfineness) % xfineness;
 
-    // Bumper event
+    // Xline event
 
-    this->_grid.each <xline> (x, 0, [&](xline & xline)
+    this->_grid.each <xline> (level, x, [&](xline & xline)
     {
       events :: xline * event = new events :: xline(molecule, fold, xline);
 
@@ -373,65 +877,182 @@ void engine :: refresh(molecule & molecule, const size_t & skip)
     });
   }
 
-  for(ssize_t dx = -1; dx <= 1; dx++)
-    for(ssize_t dy = -1; dy <= 1; dy++)
+  // Neighbouring regions, in every level of the grid
+
+  this->_grid.around(molecule.mark, [&](const size_t & level, const size_t & x, const size_t & y, const int & fold)
+  {
+    // Molecule event
+
+#ifndef __monatomic__
+    if(molecule.size() == 1)
+#endif
     {
-      ssize_t x = molecule.mark.x() + dx;
-      ssize_t y = molecule.mark.y() + dy;
+      // Contact times against the whole region at once: events are built only for the molecules that are hit
 
-      int fold = vec :: direct;
+      this->_grid.each <grid :: block> (level, x, y, [&](const grid :: block & block)
+      {
+        if(this->_contacts.size() < block.size)
+          this->_contacts.resize(block.size);
 
-      if(x < 0)
-        fold |= vec :: right;
-      else if(x >= static_cast<ssize_t>(this->_grid.fineness()))
-        fold |= vec :: left;
+        events :: molecule :: contacts(molecule, fold, block, this->_contacts.data());
 
-      if(y < 0)
-        fold |= vec :: up;
-      else if(y >= static_cast<ssize_t>(this->_grid.fineness()))
-        fold |= vec :: down;
+        for(size_t i = 0; i < block.size; i++)
+        {
+          const double & time = this->_contacts[i];
 
-      x = (x + this->_grid.fineness()) % this->_grid.fineness();
-      y = (y + this->_grid.fineness()) % this->_grid.fineness();
+          if(block.ids[i] == molecule.tag.id() || block.ids[i] == skip || time == std :: numeric_limits <double> :: infinity())
+            continue;
 
-      // Molecule event
+          class molecule & beta = *(block.molecules[i]);
 
-      this->_grid.each <class molecule> (x, y, [&](class molecule & beta)
+#ifndef __monatomic__
+          if(std :: isnan(time) || beta.size() > 1)
+#else
+          if(std :: isnan(time))
+#endif
+            this->predict(molecule, fold, beta); // Already overlapping, or atoms of the neighbour to be searched
+          else
+            this->predict(molecule, fold, beta, time);
+        }
+      });
+    }
+#ifndef __monatomic__
+    else
+      this->_grid.each <grid :: entry> (level, x, y, [&](const grid :: entry & entry)
       {
-        if(beta.tag.id() == molecule.tag.id() || beta.tag.id() == skip)
+        if(entry.id == molecule.tag.id() || entry.id == skip || events :: molecule :: misses(molecule, fold, entry))
           return;
 
-        events :: molecule * event = new events :: molecule(molecule, fold, beta, this->elasticity(molecule, beta));
-
-        if (isnan(event->time()) && event->happens())
-        {
-          std::cout << "MOLECULE NAN!" << std::endl;
-          exit(0);
-        }
-        if(event->happens())
-        {
-          event->each(this, &engine :: incref);
-          this->_events.push(event);
-        }
-        else
-          delete event;
+        this->predict(molecule, fold, *(entry.molecule));
       });
+#endif
 
-      // Bumper event
+    // Bumper event
 
-      this->_grid.each <bumper> (x, y, [&](bumper & bumper)
+    this->_grid.each <bumper> (level, x, y, [&](bumper & bumper)
+    {
+      events :: bumper * event = new events :: bumper(molecule, fold, bumper);
+
+      if(event->happens())
       {
-        events :: bumper * event = new events :: bumper(molecule, fold, bumper);
+        event->each(this, &engine :: incref);
+        this->_events.push(event);
+      }
+      else
+        delete event;
+    });
+  });
+}
 
-        if(event->happens())
-        {
-          event->each(this, &engine :: incref);
-          this->_events.push(event);
-        }
-        else
-          delete event;
-      });
+void engine :: predict(molecule & alpha, const int & fold, molecule & beta)
+{
+  events :: molecule * event = new events :: molecule(alpha, fold, beta, this);
+
+  if (isnan(event->time()) && event->happens())
+  {
+    std::cout << "MOLECULE NAN!" << std::endl;
+    exit(0);
+  }
+  if(event->happens())
+  {
+    event->each(this, &engine :: incref);
+    this->_events.push(event);
+  }
+  else
+    delete event;
+}
+
+void engine :: predict(molecule & alpha, const int & fold, molecule & beta, const double & time)
+{
+  events :: molecule * event = new events :: molecule(alpha, fold, beta, time, this);
+
+  event->each(this, &engine :: incref);
+  this->_events.push(event);
+}
+
+void engine :: thermostat(const sparseset <molecule *> * population, const double & ratio)
+{
+  // Scaling all velocities of a population by the same ratio runs its trajectories along the same paths, only faster or slower:
+  // an event among its members still happens, at its time rescaled around the present. Only pairs straddling the population need a new prediction.
+
+  auto members = [&](const auto & callback)
+  {
+    if(population)
+      population->each(callback);
+    else
+      this->_molecules.each(callback);
+  };
+
+  double origin = this->_time;
+
+  members([&](molecule * molecule)
+  {
+    origin = std :: max(origin, molecule->time());
+  });
+
+  members([&](molecule * molecule)
+  {
+    molecule->integrate(origin);
+    this->check_position(*molecule);
+    molecule->scale_velocity(ratio);
+    this->_grid.sync(*molecule);
+  });
+
+  this->_thermostat.population = population;
+
+  std :: vector <event *> queue;
+  queue.reserve(this->_events.size());
+
+  while(this->_events.size())
+    queue.push_back(this->_events.pop());
+
+  for(event * event : queue)
+  {
+    if(!(event->current()))
+    {
+      this->discard(event);
+      continue;
     }
+
+    this->_thermostat.scaled = 0;
+    this->_thermostat.others = 0;
+
+    event->each(this, &engine :: census);
+
+    if(!(this->_thermostat.scaled))
+      this->_events.push(event);
+    else if(!(this->_thermostat.others) && ratio > 0)
+    {
+      event->_time = origin + (event->_time - origin) / ratio;
+      this->_events.push(event);
+    }
+    else
+      this->discard(event); // Straddling the population (predicted again below), or never happening now that the population is at rest
+  }
+
+  this->_thermostat.population = nullptr; // Only read by census above: the population may be local to the caller
+
+  if(!population)
+    return;
+
+  members([&](molecule * molecule)
+  {
+    this->_grid.around(molecule->mark, [&](const size_t & level, const size_t & x, const size_t & y, const int & fold)
+    {
+      this->_grid.each <grid :: entry> (level, x, y, [&](const grid :: entry & entry)
+      {
+        if(population->has(slotmap <class molecule *> :: index(entry.id)) || events :: molecule :: misses(*molecule, fold, entry))
+          return;
+
+        this->predict(*molecule, fold, *(entry.molecule));
+      });
+    });
+  });
+}
+
+void engine :: sync(molecule & molecule, const size_t &)
+{
+  this->_grid.sync(molecule);
 }
 
 void engine :: incref(molecule & molecule, const size_t &)
@@ -442,21 +1063,69 @@ void engine :: incref(molecule & molecule, const size_t &)
 void engine :: decref(molecule & molecule, const size_t &)
 {
   molecule.tag--;
+
+  if(!(molecule.tag.references()) && molecule.version() < 0)
+    this->destroy(&molecule);
+}
+
+void engine :: census(molecule & molecule, const size_t &)
+{
+  if(!(this->_thermostat.population) || this->_thermostat.population->has(slotmap <class molecule *> :: index(molecule.tag.id())))
+    this->_thermostat.scaled++;
+  else
+    this->_thermostat.others++;
 }
 
-void engine :: collect()
+void engine :: inspect(molecule & molecule, const size_t &)
 {
-  set <molecule *> old;
+  if(!(this->_collapse.burst) || molecule.tag._burst < this->_collapse.burst)
+    return;
 
-  this->_garbage.each([&](molecule * entry)
-  {
-    if(!(entry->tag.references()))
-      old.add(entry);
-  });
+  // Collisions pile up in finite time: the molecule is reported through collapsed() and the run stops before it stalls
 
-  old.each([&](molecule * entry)
-  {
-    this->_garbage.remove(entry);
+  this->_collapse.molecules.push_back(molecule.tag.id());
+  this->_collapse.stalled = true;
+  this->_collapse.time = molecule.time();
+
+  molecule.tag._burst = 0;
+}
+
+void engine :: discard(event * event)
+{
+  // References are dropped only once the event is resolved and nobody reads it anymore: removed molecules can go away right here
+
+  event->each(this, &engine :: decref);
+  delete event;
+}
+
+void engine :: destroy(molecule * entry)
+{
+  // Molecules placed by a reordering share one block, which is released by the next reordering
+
+  if(entry >= this->_storage.block && entry < this->_storage.block + this->_storage.size)
+    entry->~molecule();
+  else
     delete entry;
-  });
+}
+
+// Private static methods
+
+uint32_t engine :: morton(const vec & position)
+{
+  // Interleaves the bits of the coordinates, quantized to 16 bits each
+
+  auto spread = [](uint32_t value)
+  {
+    value = (value | (value << 8)) & 0x00ff00ff;
+    value = (value | (value << 4)) & 0x0f0f0f0f;
+    value = (value | (value << 2)) & 0x33333333;
+    value = (value | (value << 1)) & 0x55555555;
+
+    return value;
+  };
+
+  uint32_t x = (uint32_t) std :: min(std :: max(position.x * 65536., 0.), 65535.);
+  uint32_t y = (uint32_t) std :: min(std :: max(position.y * 65536., 0.), 65535.);
+
+  return spread(x) | (spread(y) << 1);
 }
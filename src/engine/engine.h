@@ -2,6 +2,7 @@
 
 #ifdef _MSC_VER
 #include <BaseTsd.h>
+#include <intrin.h>
 typedef SSIZE_T ssize_t;
 #endif
 
@@ -13,10 +14,16 @@ class engine;
 // Libraries
 
 #include <chrono>
+#include <cmath>
+#include <limits>
 #include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 #include <type_traits>
+#include <vector>
+#include <algorithm>
+#include <new>
+#include <assert.h>
 
 // Forward includes
 
@@ -24,17 +31,22 @@ class engine;
 #include "molecule/molecule.h"
 #include "elements/bumper.h"
 #include "elements/line.h"
+#include "event/events/molecule.h"
+#include "event/events/sample.h"
 #undef __forward__
 
 // Includes
 
 #include "data/heap.hpp"
-#include "data/hashtable.hpp"
+#include "data/slotmap.hpp"
+#include "data/sparseset.hpp"
 #include "data/set.hpp"
 #include "grid.hpp"
 #include "event/event.h"
 #include "callback/dispatcher.h"
+#include "callback/callbacks/sample.h"
 #include "resetter.h"
+#include "stream.h"
 
 class engine
 {
@@ -43,6 +55,10 @@ public:
   // Friends
 
   friend class resetter;
+  friend class stream;
+  friend class events :: molecule;
+  friend class events :: sample;
+  template <typename...> friend class static_engine;
 
   // Nested classes
 
@@ -50,7 +66,8 @@ public:
   {
     // Settings
 
-    static constexpr size_t tags = 8;
+    static constexpr size_t tags = 256;
+    static constexpr size_t words = tags / 64;
 
     // Friends
 
@@ -59,8 +76,12 @@ public:
     // Members
 
     size_t _id;
-    uint8_t _tags[tags];
+    uint64_t _mask[words]; // One bit per tag
     size_t _references;
+    uint16_t _material; // Class of the molecule in the restitution matrix of its engine
+
+    double _impact; // Time of the last collision with another molecule
+    size_t _burst; // Collisions in a row, each within the watchdog interval of the previous one
 
   public:
 
@@ -73,6 +94,13 @@ public:
     const size_t & id() const;
     size_t size() const;
     const size_t & references() const;
+    const uint16_t & material() const;
+
+    bool has(const uint8_t &) const;
+
+    // Methods
+
+    template <typename lambda> void each(const lambda &) const;
 
   private:
 
@@ -97,13 +125,25 @@ public:
     void operator -- ();
     void operator -- (int);
 
-    // Private static members
+    // Private static methods
 
-    static size_t autoincrement;
+    static size_t count(const uint64_t &);
+    static size_t lowest(const uint64_t &);
   };
 
 private:
 
+  // Settings
+
+  static constexpr double occupancy = 2.; // Molecules per region targeted by automatic grids
+  static constexpr size_t window = 8; // Resolved events per molecule between two checks of an automatic grid
+  static constexpr double drift = 2.; // Change of the crossings per collision ratio that triggers a regrid
+  static constexpr size_t depth = 8; // Maximum number of levels of automatic grids
+  static constexpr size_t period = 64; // Resolved events per molecule between two reorderings of the molecule storage
+
+  static constexpr uint16_t untagged = 0; // Material class of molecules without tags
+  static constexpr uint16_t generic = 1; // Material class of molecules whose tags have no coefficient of their own, or with more than one tag
+
   // Members
 
   std::chrono::steady_clock::time_point begin, end, mid;
@@ -111,22 +151,75 @@ private:
   heap <event :: wrapper> _events;
   grid _grid;
 
-  hashtable <size_t, molecule *> _molecules;
+  slotmap <molecule *> _molecules; // Ids are handles to the slots
   set <bumper *> _bumpers;
   set <xline *> _xlines;
 
-  hashtable <size_t, molecule *> * _tags;
-  set <molecule *> _garbage;
+  sparseset <molecule *> * _tags; // Members of each tag, keyed on the slot of their id
 
   dispatcher _dispatcher;
 
   struct
   {
     double all;
-    double stag[255];
-    double dtag[255][255];
+    uint16_t classes[256]; // Material class of each tag, generic until the tag gets a coefficient
+
+    size_t size; // Material classes in use
+    std :: vector <double> single; // Coefficient of each class against untagged molecules, negative if not set
+    std :: vector <double> pair; // Coefficient of each pair of classes, negative if not set
+    std :: vector <double> matrix; // Coefficient of each pair of classes, as resolved from the settings
   } _elasticity;
 
+  struct
+  {
+    double tc; // Collisions are elastic if either molecule collided less than tc before (0 disables the TC model)
+    double interval;
+    size_t burst; // 0 (the default) disables the watchdog: a sensible interval depends on the time units of the system
+    std :: vector <size_t> molecules; // Ids of the molecules flagged so far
+    bool stalled; // Set when a molecule is flagged, stops the current run
+    double time; // Time of the collision that flagged the last molecule
+  } _collapse;
+
+  struct
+  {
+    std :: vector <double> times;
+    :: callback <events :: sample> * sampler;
+    size_t version;
+  } _schedule;
+
+  struct
+  {
+    bool automatic;
+    size_t molecules;
+    double radius;
+    double smallest;
+    double bumper;
+
+    size_t crossings;
+    size_t collisions;
+    double reference;
+
+    bool pending; // Set by account: the grid below is applied by resize once no event is in flight
+    size_t fineness;
+    size_t levels;
+  } _regrid;
+
+  struct
+  {
+    const sparseset <molecule *> * population; // Molecules whose velocities are being scaled, keyed on the slot of their id (nullptr for all of them), only set while thermostat runs
+    size_t scaled; // Molecules of the event being inspected inside the population
+    size_t others; // Molecules of the event being inspected outside the population
+  } _thermostat;
+
+  struct
+  {
+    molecule * block; // Molecules placed by the last reordering, in Morton order
+    size_t size;
+    size_t events;
+  } _storage;
+
+  std :: vector <double> _contacts; // Scratch space for the contact times of a region, see refresh
+
   double _time;
 
 public:
@@ -137,7 +230,9 @@ public:
 
   // Constructors
 
+  engine();
   engine(const size_t &);
+  engine(const size_t &, const size_t &);
 
   // Destructor
 
@@ -146,7 +241,13 @@ public:
   // Getters
 
   const size_t & fineness() const;
+  const size_t & xfineness() const;
+  const size_t & yfineness() const;
+  const size_t & levels() const;
   const size_t & event_heap_size() const;
+  const size_t & molecule_count() const;
+  const std :: vector <size_t> & collapsed() const;
+  const double & time() const;
 
   // Setters
 
@@ -154,18 +255,33 @@ public:
   void elasticity(const uint8_t &, const double &);
   void elasticity(const uint8_t &, const uint8_t &, const double &);
 
+  void collapse(const double &);
+  void watchdog(const double &, const size_t &);
+
   // Methods
 
   size_t add(const molecule &);
+  size_t add(const molecule &, const vec &, const vec & = vec(0, 0), const double & = 0, const double & = 0);
   void add(const bumper &);
   void add(const xline &);
 
-  void remove(const size_t &);
+  bool remove(const size_t &);
+  void reserve(const size_t &);
+
+  bool tag(const size_t &, const uint8_t &);
+  bool untag(const size_t &, const uint8_t &);
 
-  void tag(const size_t &, const uint8_t &);
-  void untag(const size_t &, const uint8_t &);
+  void regrid();
+  void regrid(const size_t &);
+  void regrid(const size_t &, const size_t &);
+  void regrid(const size_t &, const size_t &, const size_t &);
+  void reorder();
 
-  void run(const double &);
+  template <typename lambda> void schedule(const std :: vector <double> &, const lambda &); // TODO: Add validation for lambda
+  void unschedule();
+
+  bool run(const double &);
+  stream events_until(const double &);
 
   template <typename type, typename lambda, typename std :: enable_if <std :: is_same <type, molecule> :: value> :: type * = nullptr> void each(const lambda &) const; // TODO: Add validation for lambda
   template <typename type, typename lambda, typename std :: enable_if <std :: is_same <type, molecule> :: value> :: type * = nullptr> void each(const uint8_t &, const lambda &) const; // TODO: Add validation for lambda
@@ -185,15 +301,42 @@ private:
 
   // Private methods
 
-  double elasticity(const molecule &, const molecule &);
-
+  template <typename stype> void loop(const double &, stype &);
+  event * next(const double &);
+  void settle(const double &);
+  void sample(const events :: sample &);
+
+  double elasticity(const molecule &, const molecule &) const;
+  double restitution(molecule &, molecule &, const double &) const;
+  uint16_t material(const uint8_t &);
+  void classify(molecule &);
+  void tabulate();
+
+  size_t insert(molecule *);
+  void rebuild(const size_t &, const size_t &, const size_t &);
+  void relocate();
+  size_t limit() const;
+  size_t levels(const size_t &) const;
+  void account(const event *);
+  void resize();
   void check_position(molecule &);
   void refresh(molecule &, const size_t & = 0);
+  void predict(molecule &, const int &, molecule &);
+  void predict(molecule &, const int &, molecule &, const double &);
+  void thermostat(const sparseset <molecule *> *, const double &);
 
+  void sync(molecule &, const size_t &);
   void incref(molecule &, const size_t &);
   void decref(molecule &, const size_t &);
+  void census(molecule &, const size_t &);
+  void inspect(molecule &, const size_t &);
+
+  void discard(event *);
+  void destroy(molecule *);
+
+  // Private static methods
 
-  void collect();
+  static uint32_t morton(const vec &);
 };
 
 #endif
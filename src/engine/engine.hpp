@@ -2,8 +2,26 @@
 #define __nobb__engine__engine__hpp
 
 #include "engine.h"
+#include "stream.hpp"
+#include "callback/callbacks/sample.hpp"
+#include "event/events/sample.h"
 #include "molecule/molecule.h"
 
+// tag
+
+// Methods
+
+template <typename lambda> void engine :: tag :: each(const lambda & callback) const
+{
+  // Set bits are visited in increasing order, skipping empty words altogether
+
+  for(size_t word = 0; word < words; word++)
+    for(uint64_t mask = this->_mask[word]; mask; mask &= mask - 1)
+      callback((uint8_t) (64 * word + lowest(mask)));
+}
+
+// engine
+
 // Methods
 
 template <typename type, typename lambda, typename std :: enable_if <std :: is_same <type, molecule> :: value> :: type *> void engine :: each(const lambda & callback) const
@@ -40,6 +58,19 @@ template <typename type, typename lambda, typename std :: enable_if <std :: is_s
   });
 }
 
+template <typename lambda> void engine :: schedule(const std :: vector <double> & times, const lambda & callback)
+{
+  assert(std :: is_sorted(times.begin(), times.end()) && (times.empty() || times.front() >= this->_time));
+
+  this->unschedule();
+
+  this->_schedule.times = times;
+  this->_schedule.sampler = new :: callback <events :: sample, lambda> (callback);
+
+  if(times.size())
+    this->_events.push(event :: wrapper(new events :: sample(*this, 0)));
+}
+
 template <typename etype, typename lambda, typename std :: enable_if <std :: is_same <etype, events :: molecule> :: value || std :: is_same <etype, events :: bumper> :: value || std :: is_same <etype, events :: xline> :: value> :: type *> size_t engine :: on(const lambda & callback)
 {
   :: callback <etype> * wrapper = new :: callback <etype, lambda> (callback);
@@ -63,4 +94,64 @@ template <typename etype, typename std :: enable_if <std :: is_same <etype, even
   this->_dispatcher.remove <etype> (id);
 }
 
+// Private methods
+
+template <typename stype> void engine :: loop(const double & time, stype & sink)
+{
+  begin = std::chrono::steady_clock::now();
+  end = std::chrono::steady_clock::now();
+  mid = std::chrono::steady_clock::now();
+  double ETA;
+  double starting_time = this->_time;
+  unsigned int mins, hours, secs;
+
+  if(this->_regrid.automatic && this->_regrid.molecules != this->_molecules.size())
+    this->regrid();
+
+  this->resize();
+
+  this->_collapse.stalled = false;
+
+  while(!(this->_collapse.stalled) && this->_events.size() && ((const event *) (this->_events.peek()))->time() <= time)
+  {
+    if (std::chrono::duration_cast<std::chrono::seconds>(end - mid).count() > 10)
+    {
+      mid = std::chrono::steady_clock::now();
+      ETA = std::chrono::duration_cast<std::chrono::seconds>(mid - begin).count() * (time - ((const event *)(this->_events.peek()))->time()) / (((const event *)(this->_events.peek()))->time() - starting_time);
+      secs = fmod(ETA, 60);
+      mins = int(ETA / 60) % 60;
+      hours = mins / 60;
+      std::cout << "(" << starting_time << " -> " << ((const event *)(this->_events.peek()))->time() << " -> " << time << ") "
+                << "ETA: " << hours << "h" << mins << "m" << secs << "s" << std::endl;
+    }
+
+    event * event = this->_events.pop();
+
+    if(event->resolve())
+    {
+      event->each(this, &engine :: sync); // All involved molecules first: refresh reads neighbours from the grid
+      event->each(this, &engine :: refresh);
+
+      if(!(stype :: empty)) // Resolved at compile time: static engines without observers skip dispatching altogether
+        sink.trigger(event);
+
+      if(this->_regrid.automatic)
+        this->account(event);
+
+      if(event->type() == event :: molecule_kind)
+        event->each(this, &engine :: inspect);
+    }
+
+    this->discard(event);
+    this->resize(); // No event is in flight: the grid picked by account can be applied, moving the molecules
+
+    if(++(this->_storage.events) > period * this->_molecules.size())
+      this->reorder();
+
+    end = std::chrono::steady_clock::now();
+  }
+
+  this->settle(time);
+}
+
 #endif
@@ -18,6 +18,11 @@ void my_in_assert(bool element)
 
 // Getters
 
+size_t grid :: mark :: level() const
+{
+  return this->_level;
+}
+
 size_t grid :: mark :: x() const
 {
   return this->_x;
@@ -28,72 +33,101 @@ size_t grid :: mark :: y() const
   return this->_y;
 }
 
+size_t grid :: mark :: slot() const
+{
+  return this->_slot;
+}
+
 // grid
 
 // Constructors
 
-grid :: grid(const size_t & fineness) : _fineness(fineness)
+grid :: grid(const size_t & fineness) : grid(fineness, fineness)
 {
-  this->_molecules = new set <molecule *> * [this->_fineness];
-
-  for(size_t i = 0; i < this->_fineness; i++)
-    this->_molecules[i] = new set <molecule *> [this->_fineness];
-
-  this->_bumpers = new set <bumper *> * [this->_fineness];
-
-  for(size_t i = 0; i < this->_fineness; i++)
-    this->_bumpers[i] = new set <bumper *> [this->_fineness];
+}
 
-  this->_xlines = new set <xline *> * [this->_fineness];
+grid :: grid(const size_t & xfineness, const size_t & yfineness) : grid(xfineness, yfineness, 1)
+{
+}
 
-  for(size_t i = 0; i < this->_fineness; i++)
-    this->_xlines[i] = new set <xline *> [this->_fineness];
+grid :: grid(const size_t & xfineness, const size_t & yfineness, const size_t & depth) : _levels(nullptr), _depth(0)
+{
+  this->reset(xfineness, yfineness, depth);
 }
 
 // Destructor
 
 grid :: ~grid()
 {
-  for(size_t i = 0; i < this->_fineness; i++)
-  {
-    delete [] this->_molecules[i];
-    delete [] this->_bumpers[i];
-    delete [] this->_xlines[i];
-  }
-  delete [] this->_molecules;
-  delete [] this->_bumpers;
-  delete [] this->_xlines;
+  delete [] this->_levels;
 }
 
 // Getters
 
 const size_t & grid :: fineness() const
 {
-  return this->_fineness;
+  assert(this->_levels[0].xfineness == this->_levels[0].yfineness && "fineness() is only defined for square grids: use xfineness() and yfineness()");
+  return this->_levels[0].xfineness;
+}
+
+const size_t & grid :: xfineness() const
+{
+  return this->_levels[0].xfineness;
+}
+
+const size_t & grid :: yfineness() const
+{
+  return this->_levels[0].yfineness;
+}
+
+const size_t & grid :: xfineness(const size_t & level) const
+{
+  return this->_levels[level].xfineness;
+}
+
+const size_t & grid :: yfineness(const size_t & level) const
+{
+  return this->_levels[level].yfineness;
+}
+
+const size_t & grid :: levels() const
+{
+  return this->_depth;
 }
 
 // Methods
 
 void grid :: add(molecule & molecule)
 {
-  this->add(molecule, (size_t) (molecule.position().x * this->_fineness), (size_t) (molecule.position().y * this->_fineness));
+  size_t level = this->fit(molecule.radius());
+  this->add(molecule, level, (size_t) (molecule.position().x * this->_levels[level].xfineness), (size_t) (molecule.position().y * this->_levels[level].yfineness));
 }
 
 void grid :: add(bumper & bumper)
 {
-  this->add(bumper, (size_t) (bumper.position().x * this->_fineness), (size_t) (bumper.position().y * this->_fineness));
+  size_t level = this->fit(bumper.radius());
+  this->add(bumper, level, (size_t) (bumper.position().x * this->_levels[level].xfineness), (size_t) (bumper.position().y * this->_levels[level].yfineness));
 }
 
 void grid :: add(xline & xline)
 {
-  // xlines by default occupy the grid in the y-zero-sector.
-  // from this, everything is consequent in the refresh() method in the engine.
-  this->add(xline, (size_t) (xline.xposition() * this->_fineness), (size_t) 0);
+  // xlines are indexed by column only, in every level: refresh() checks the columns around the molecule in its own level.
+
+  for(size_t level = this->_depth; level-- > 0;)
+    this->add(xline, level, (size_t) (xline.xposition() * this->_levels[level].xfineness));
 }
 
 void grid :: remove(molecule & molecule)
 {
-  this->_molecules[molecule.mark._x][molecule.mark._y].remove(&molecule);
+  auto & molecules = this->_levels[molecule.mark._level].molecules;
+
+  size_t cell = this->cell(molecule.mark._level, molecule.mark._x, molecule.mark._y);
+  molecules.remove(cell, molecule.mark._slot);
+
+  // The last molecule of the cell took the removed slot
+
+  if(molecule.mark._slot < molecules.size(cell))
+    molecules.get <handles> (cell)[molecule.mark._slot]->mark._slot = molecule.mark._slot;
 }
 
 void grid :: update(molecule & molecule, const vec :: fold & fold)
@@ -141,39 +175,99 @@ void grid :: update(molecule & molecule, const vec :: fold & fold)
       flag = false;
   } while(flag);
 
-  if(!((size_t)trunc(molecule.position().x * this->_fineness) < this->_fineness && (size_t)trunc(molecule.position().y * this->_fineness) < this->_fineness))
+  // Molecules keep their level: it only depends on their radius
+
+  size_t level = molecule.mark._level;
+  const size_t & xfineness = this->_levels[level].xfineness;
+  const size_t & yfineness = this->_levels[level].yfineness;
+
+  if(!((size_t)trunc(molecule.position().x * xfineness) < xfineness && (size_t)trunc(molecule.position().y * yfineness) < yfineness))
   {
     std::cout << molecule.position().x << " " << molecule.position().y << std::endl;
     exit(0);
   }
 
-  this->add(molecule, trunc(molecule.position().x * this->_fineness), trunc(molecule.position().y * this->_fineness));
+  this->add(molecule, level, trunc(molecule.position().x * xfineness), trunc(molecule.position().y * yfineness));
 
   //std::cout << "after: " << molecule.mark.x() << " " << molecule.mark.y() << std::endl;
 }
 
+void grid :: sync(molecule & molecule)
+{
+  auto & molecules = this->_levels[molecule.mark._level].molecules;
+
+  size_t cell = this->cell(molecule.mark._level, molecule.mark._x, molecule.mark._y);
+  const size_t & slot = molecule.mark._slot;
+
+  molecules.get <positions> (cell)[slot] = molecule.position();
+  molecules.get <velocities> (cell)[slot] = molecule.velocity();
+  molecules.get <times> (cell)[slot] = molecule.time();
+}
+
+void grid :: reset(const size_t & xfineness, const size_t & yfineness, const size_t & depth)
+{
+  level * levels = new level [depth]; // The arguments may refer to the current levels
+
+  for(size_t i = 0; i < depth; i++)
+  {
+    level & level = levels[i];
+
+    level.xfineness = xfineness << i;
+    level.yfineness = yfineness << i;
+
+    level.molecules.reset(level.xfineness * level.yfineness);
+    level.bumpers.reset(level.xfineness * level.yfineness);
+    level.xlines.reset(level.xfineness);
+  }
+
+  delete [] this->_levels;
+
+  this->_levels = levels;
+  this->_depth = depth;
+}
+
 // Private Methods
 
-void grid :: add(molecule & molecule, const size_t & x, const size_t & y)
+void grid :: add(molecule & molecule, const size_t & level, const size_t & x, const size_t & y)
 {
+  molecule.mark._level = level;
   molecule.mark._x = x;
   molecule.mark._y = y;
 
-  this->_molecules[molecule.mark._x][molecule.mark._y].add(&molecule);
+  molecule.mark._slot = this->_levels[level].molecules.add(this->cell(level, x, y), molecule.position(), molecule.velocity(), molecule.time(), molecule.radius(), molecule.tag.id(), &molecule);
 }
 
-void grid :: add(bumper & bumper, const size_t & x, const size_t & y)
+void grid :: add(bumper & bumper, const size_t & level, const size_t & x, const size_t & y)
 {
+  bumper.mark._level = level;
   bumper.mark._x = x;
   bumper.mark._y = y;
 
-  this->_bumpers[bumper.mark._x][bumper.mark._y].add(&bumper);
+  this->_levels[level].bumpers.add(this->cell(level, x, y), &bumper);
 }
 
-void grid :: add(xline & xline, const size_t & x, const size_t & y)
+void grid :: add(xline & xline, const size_t & level, const size_t & x)
 {
+  xline.mark._level = level;
   xline.mark._x = x;
-  xline.mark._y = y;
+  xline.mark._y = 0;
+
+  this->_levels[level].xlines.add(x, &xline);
+}
 
-  this->_xlines[xline.mark._x][xline.mark._y].add(&xline);
-}
\ No newline at end of file
+size_t grid :: fit(const double & radius) const
+{
+  // Finest level whose regions are at least as large as the diameter: any interaction range then fits in the regions of the coarser of the two partners
+
+  size_t level = 0;
+
+  while(level + 1 < this->_depth && 2. * radius * this->_levels[level + 1].xfineness <= 1. && 2. * radius * this->_levels[level + 1].yfineness <= 1.)
+    level++;
+
+  return level;
+}
+
+size_t grid :: cell(const size_t & level, const size_t & x, const size_t & y) const
+{
+  return x * this->_levels[level].yfineness + y;
+}
@@ -7,7 +7,13 @@ class grid;
 
 // Libraries
 
+#ifdef _MSC_VER
+#include <BaseTsd.h>
+typedef SSIZE_T ssize_t;
+#endif
+
 #include <stddef.h>
+#include <sys/types.h>
 #include <type_traits>
 
 // Forward includes
@@ -21,7 +27,7 @@ class grid;
 // Includes
 
 #include "geometry/vec.h"
-#include "data/set.hpp"
+#include "data/cells.hpp"
 
 class grid
 {
@@ -37,32 +43,74 @@ public:
 
     // Members
 
+    size_t _level;
     size_t _x;
     size_t _y;
+    size_t _slot;
 
   public:
 
     // Getters
 
+    size_t level() const;
     size_t x() const;
     size_t y() const;
+    size_t slot() const;
+  };
+
+  // Hot copy of the state of a molecule, as read from the columns of its cell
+
+  struct entry
+  {
+    vec position;
+    vec velocity;
+    double time;
+    double radius;
+    size_t id;
+    :: molecule * molecule;
+  };
+
+  // Columns of all the molecules of a cell, for batch predictions
+
+  struct block
+  {
+    const vec * positions;
+    const vec * velocities;
+    const double * times;
+    const double * radii;
+    const size_t * ids;
+    :: molecule * const * molecules;
+    size_t size;
   };
 
 private:
 
-  // Members
+  // Service nested classes
 
-  size_t _fineness;
+  struct level // Level k has 2^k times the columns and rows of level 0
+  {
+    size_t xfineness;
+    size_t yfineness;
 
-  set <molecule *> ** _molecules;
-  set <bumper *> ** _bumpers;
-  set <xline *> ** _xlines;
+    cells <vec, vec, double, double, size_t, :: molecule *> molecules; // Hot state of the molecules, one column per field (see enum column)
+    cells <bumper *> bumpers;
+    cells <xline *> xlines; // One cell per column: xlines span the whole height
+  };
+
+  enum column {positions, velocities, times, radii, ids, handles};
+
+  // Members
+
+  level * _levels;
+  size_t _depth;
 
 public:
 
   // Constructors
 
   grid(const size_t &);
+  grid(const size_t &, const size_t &);
+  grid(const size_t &, const size_t &, const size_t &);
 
   // Destructor
 
@@ -71,6 +119,11 @@ public:
   // Getters
 
   const size_t & fineness() const;
+  const size_t & xfineness() const;
+  const size_t & yfineness() const;
+  const size_t & xfineness(const size_t &) const;
+  const size_t & yfineness(const size_t &) const;
+  const size_t & levels() const;
 
   // Methods
 
@@ -79,18 +132,27 @@ public:
   void add(xline &);
   void remove(molecule &);
   void update(molecule &, const vec :: fold &);
+  void sync(molecule &);
+  void reset(const size_t &, const size_t &, const size_t & = 1);
 
-  template <typename type, typename lambda, typename std :: enable_if <std :: is_same <type, molecule> :: value> :: type * = nullptr> void each(const size_t &, const size_t &, const lambda &); // TODO: Add validation for lambda
-  template <typename type, typename lambda, typename std :: enable_if <std :: is_same <type, bumper> :: value> :: type * = nullptr> void each(const size_t &, const size_t &, const lambda &); // TODO: Add validation for lambda
+  template <typename type, typename lambda, typename std :: enable_if <std :: is_same <type, molecule> :: value> :: type * = nullptr> void each(const size_t &, const size_t &, const size_t &, const lambda &); // TODO: Add validation for lambda
+  template <typename type, typename lambda, typename std :: enable_if <std :: is_same <type, entry> :: value> :: type * = nullptr> void each(const size_t &, const size_t &, const size_t &, const lambda &); // TODO: Add validation for lambda
+  template <typename type, typename lambda, typename std :: enable_if <std :: is_same <type, block> :: value> :: type * = nullptr> void each(const size_t &, const size_t &, const size_t &, const lambda &); // TODO: Add validation for lambda
+  template <typename type, typename lambda, typename std :: enable_if <std :: is_same <type, bumper> :: value> :: type * = nullptr> void each(const size_t &, const size_t &, const size_t &, const lambda &); // TODO: Add validation for lambda
   template <typename type, typename lambda, typename std :: enable_if <std :: is_same <type, xline> :: value> :: type * = nullptr> void each(const size_t &, const size_t &, const lambda &); // TODO: Add validation for lambda
 
+  template <typename lambda> void around(const mark &, const lambda &) const; // TODO: Add validation for lambda
+
 private:
 
   // Private methods
 
-  void add(molecule &, const size_t &, const size_t &);
-  void add(bumper &, const size_t &, const size_t &);
+  void add(molecule &, const size_t &, const size_t &, const size_t &);
+  void add(bumper &, const size_t &, const size_t &, const size_t &);
   void add(xline &, const size_t &, const size_t &);
+
+  size_t fit(const double &) const;
+  size_t cell(const size_t &, const size_t &, const size_t &) const;
 };
 
 #endif
@@ -5,29 +5,97 @@
 
 // Methods
 
-template <typename type, typename lambda, typename std :: enable_if <std :: is_same <type, molecule> :: value> :: type *> void grid :: each(const size_t & x, const size_t & y, const lambda & callback)
+template <typename type, typename lambda, typename std :: enable_if <std :: is_same <type, molecule> :: value> :: type *> void grid :: each(const size_t & level, const size_t & x, const size_t & y, const lambda & callback)
 {
-  this->_molecules[x][y].each([&](molecule * molecule)
+  this->_levels[level].molecules.each(this->cell(level, x, y), [&](const vec &, const vec &, const double &, const double &, const size_t &, :: molecule * molecule)
   {
     callback(*molecule);
   });
 }
 
-template <typename type, typename lambda, typename std :: enable_if <std :: is_same <type, bumper> :: value> :: type *> void grid :: each(const size_t & x, const size_t & y, const lambda & callback)
+template <typename type, typename lambda, typename std :: enable_if <std :: is_same <type, grid :: entry> :: value> :: type *> void grid :: each(const size_t & level, const size_t & x, const size_t & y, const lambda & callback)
 {
-  this->_bumpers[x][y].each([&](bumper * bumper)
+  this->_levels[level].molecules.each(this->cell(level, x, y), [&](const vec & position, const vec & velocity, const double & time, const double & radius, const size_t & id, :: molecule * molecule)
+  {
+    callback(entry {position, velocity, time, radius, id, molecule});
+  });
+}
+
+template <typename type, typename lambda, typename std :: enable_if <std :: is_same <type, grid :: block> :: value> :: type *> void grid :: each(const size_t & level, const size_t & x, const size_t & y, const lambda & callback)
+{
+  // The whole cell at once, straight from its columns
+
+  const auto & molecules = this->_levels[level].molecules;
+  size_t cell = this->cell(level, x, y);
+
+  callback(block {molecules.get <positions> (cell), molecules.get <velocities> (cell), molecules.get <times> (cell), molecules.get <radii> (cell), molecules.get <ids> (cell), molecules.get <handles> (cell), molecules.size(cell)});
+}
+
+template <typename type, typename lambda, typename std :: enable_if <std :: is_same <type, bumper> :: value> :: type *> void grid :: each(const size_t & level, const size_t & x, const size_t & y, const lambda & callback)
+{
+  this->_levels[level].bumpers.each(this->cell(level, x, y), [&](bumper * bumper)
   {
     callback(*bumper);
   });
 }
 
 
-template <typename type, typename lambda, typename std :: enable_if <std :: is_same <type, xline> :: value> :: type *> void grid :: each(const size_t & x, const size_t & y, const lambda & callback)
+template <typename type, typename lambda, typename std :: enable_if <std :: is_same <type, xline> :: value> :: type *> void grid :: each(const size_t & level, const size_t & x, const lambda & callback)
 {
-  this->_xlines[x][y].each([&](xline * xline)
+  this->_levels[level].xlines.each(x, [&](xline * xline)
   {
     callback(*xline);
   });
 }
 
+template <typename lambda> void grid :: around(const mark & mark, const lambda & callback) const
+{
+  for(size_t level = 0; level < this->_depth; level++)
+  {
+    // Coarser levels (and the level of the mark) are scanned around the region that contains the mark, finer levels across the regions its neighbourhood covers
+
+    ssize_t xbegin, xend, ybegin, yend;
+
+    if(level <= mark._level)
+    {
+      size_t shift = mark._level - level;
+
+      xbegin = (ssize_t) (mark._x >> shift) - 1;
+      xend = (ssize_t) (mark._x >> shift) + 1;
+      ybegin = (ssize_t) (mark._y >> shift) - 1;
+      yend = (ssize_t) (mark._y >> shift) + 1;
+    }
+    else
+    {
+      ssize_t scale = (ssize_t) 1 << (level - mark._level);
+
+      xbegin = ((ssize_t) mark._x - 1) * scale;
+      xend = ((ssize_t) mark._x + 2) * scale - 1;
+      ybegin = ((ssize_t) mark._y - 1) * scale;
+      yend = ((ssize_t) mark._y + 2) * scale - 1;
+    }
+
+    ssize_t xfineness = this->_levels[level].xfineness;
+    ssize_t yfineness = this->_levels[level].yfineness;
+
+    for(ssize_t x = xbegin; x <= xend; x++)
+      for(ssize_t y = ybegin; y <= yend; y++)
+      {
+        int fold = vec :: direct;
+
+        if(x < 0)
+          fold |= vec :: right;
+        else if(x >= xfineness)
+          fold |= vec :: left;
+
+        if(y < 0)
+          fold |= vec :: up;
+        else if(y >= yfineness)
+          fold |= vec :: down;
+
+        callback(level, (size_t) ((x + xfineness) % xfineness), (size_t) ((y + yfineness) % yfineness), fold);
+      }
+  }
+}
+
 #endif
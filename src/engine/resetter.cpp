@@ -10,11 +10,18 @@ resetter :: energy :: energy(engine & engine) : _engine(engine)
 
 // Methods
 
-void resetter :: energy :: id(const size_t & id, const double & target)
+bool resetter :: energy :: id(const size_t & id, const double & target)
 {
+  if(!(this->_engine._molecules.has(id)))
+    return false;
+
   molecule * molecule = this->_engine._molecules[id];
-  molecule->scale_energy(target);
-  this->_engine.refresh(*molecule);
+
+  sparseset <class molecule *> population;
+  population.add(slotmap <class molecule *> :: index(id), molecule);
+
+  this->_engine.thermostat(&population, sqrt(target / molecule->energy()));
+  return true;
 }
 
 void resetter :: energy :: tag(const uint8_t & tag, const double & target)
@@ -25,11 +32,7 @@ void resetter :: energy :: tag(const uint8_t & tag, const double & target)
     energy += molecule->energy();
   });
 
-  this->_engine._tags[tag].each([&](molecule * molecule)
-  {
-    molecule->scale_energy(molecule->energy() * target / energy);
-    this->_engine.refresh(*molecule);
-  });
+  this->_engine.thermostat(&(this->_engine._tags[tag]), sqrt(target / energy));
 }
 
 void resetter :: energy :: all(const double & target)
@@ -40,11 +43,7 @@ void resetter :: energy :: all(const double & target)
     energy += molecule->energy();
   });
 
-  this->_engine._molecules.each([&](molecule * molecule)
-  {
-    molecule->scale_energy(molecule->energy() * target / energy);
-    this->_engine.refresh(*molecule);
-  });
+  this->_engine.thermostat(nullptr, sqrt(target / energy));
 }
 
 // resetter
@@ -38,7 +38,7 @@ class resetter
 
     // Methods
 
-    void id(const size_t &, const double &);
+    bool id(const size_t &, const double &);
     void tag(const uint8_t &, const double &);
     void all(const double &);
   };
@@ -0,0 +1,44 @@
+// Forward declarations
+
+template <typename...> class static_engine;
+
+#if !defined(__forward__) && !defined(__nobb__engine__static_engine__h)
+#define __nobb__engine__static_engine__h
+
+// Libraries
+
+#include <stddef.h>
+
+// Includes
+
+#include "engine.h"
+#include "callback/sink.h"
+
+template <typename... observers> class static_engine : public engine
+{
+  // Members
+
+  sink <observers...> _sink;
+
+public:
+
+  // Constructors
+
+  static_engine(const size_t &, const observers & ...);
+  static_engine(const size_t &, const size_t &, const observers & ...);
+
+  // Getters
+
+  template <typename otype> otype & observer();
+
+  // Methods
+
+  bool run(const double &);
+
+  // Deleted methods
+
+  template <typename etype, typename... args> size_t on(const args & ...) = delete; // Observers are fixed at compile time
+  template <typename etype> void unsubscribe(const size_t &) = delete;
+};
+
+#endif
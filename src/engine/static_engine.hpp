@@ -0,0 +1,33 @@
+#ifndef __nobb__engine__static_engine__hpp
+#define __nobb__engine__static_engine__hpp
+
+#include "static_engine.h"
+#include "engine.hpp"
+#include "callback/sink.hpp"
+
+// Constructors
+
+template <typename... observers> static_engine <observers...> :: static_engine(const size_t & fineness, const observers & ... instances) : engine(fineness), _sink(instances...)
+{
+}
+
+template <typename... observers> static_engine <observers...> :: static_engine(const size_t & xfineness, const size_t & yfineness, const observers & ... instances) : engine(xfineness, yfineness), _sink(instances...)
+{
+}
+
+// Getters
+
+template <typename... observers> template <typename otype> otype & static_engine <observers...> :: observer()
+{
+  return this->_sink.template get <otype> ();
+}
+
+// Methods
+
+template <typename... observers> bool static_engine <observers...> :: run(const double & time)
+{
+  this->loop(time, this->_sink);
+  return !(this->_collapse.stalled);
+}
+
+#endif
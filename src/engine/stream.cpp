@@ -0,0 +1,119 @@
+#include "stream.hpp"
+#include "engine.h"
+
+// record
+
+// Getters
+
+event :: kind stream :: record :: type() const
+{
+  return this->_event->type();
+}
+
+double stream :: record :: time() const
+{
+  return this->_event->time();
+}
+
+// iterator
+
+// Private constructors
+
+stream :: iterator :: iterator(stream * stream) : _stream(stream)
+{
+}
+
+// Operators
+
+const stream :: record & stream :: iterator :: operator * () const
+{
+  return this->_stream->_record;
+}
+
+const stream :: record * stream :: iterator :: operator -> () const
+{
+  return &(this->_stream->_record);
+}
+
+stream :: iterator & stream :: iterator :: operator ++ ()
+{
+  this->_stream->advance();
+
+  if(!(this->_stream->_event))
+    this->_stream = nullptr;
+
+  return *this;
+}
+
+bool stream :: iterator :: operator == (const iterator & rho) const
+{
+  return this->_stream == rho._stream;
+}
+
+bool stream :: iterator :: operator != (const iterator & rho) const
+{
+  return this->_stream != rho._stream;
+}
+
+// stream
+
+// Constructors
+
+stream :: stream(engine & engine, const double & time) : _engine(&engine), _time(time), _event(nullptr), _started(false)
+{
+}
+
+stream :: stream(stream && that) : _engine(that._engine), _time(that._time), _event(that._event), _record(that._record), _started(that._started)
+{
+  that._engine = nullptr;
+  that._event = nullptr;
+}
+
+// Destructor
+
+stream :: ~stream()
+{
+  if(!(this->_engine) || !(this->_started))
+    return;
+
+  if(this->_event)
+  {
+    // Stopped early: the engine is left at the time of the last event handed out
+
+    double time = this->_event->time();
+    this->_engine->discard(this->_event);
+
+    this->_engine->settle(time);
+  }
+  else
+    this->_engine->settle(this->_time);
+}
+
+// Methods
+
+stream :: iterator stream :: begin()
+{
+  if(!(this->_started))
+  {
+    this->_started = true;
+    this->advance();
+  }
+
+  return iterator(this->_event ? this : nullptr);
+}
+
+stream :: iterator stream :: end()
+{
+  return iterator(nullptr);
+}
+
+// Private methods
+
+void stream :: advance()
+{
+  if(this->_event)
+    this->_engine->discard(this->_event);
+
+  this->_event = this->_engine->next(this->_time);
+  this->_record._event = this->_event;
+}
@@ -0,0 +1,111 @@
+// Forward declarations
+
+class stream;
+
+#if !defined(__forward__) && !defined(__nobb__engine__stream__h)
+#define __nobb__engine__stream__h
+
+// Libraries
+
+#include <stddef.h>
+
+// Forward includes
+
+#define __forward__
+#include "engine.h"
+#include "event/reports/molecule.h"
+#undef __forward__
+
+// Includes
+
+#include "event/event.h"
+
+class stream
+{
+public:
+
+  // Nested classes
+
+  class record
+  {
+    // Friends
+
+    friend class stream;
+
+    // Members
+
+    const event * _event;
+
+  public:
+
+    // Getters
+
+    event :: kind type() const;
+    double time() const;
+
+    template <typename etype> report <etype> get() const;
+  };
+
+  class iterator
+  {
+    // Friends
+
+    friend class stream;
+
+    // Members
+
+    stream * _stream;
+
+    // Private constructors
+
+    iterator(stream *);
+
+  public:
+
+    // Operators
+
+    const record & operator * () const;
+    const record * operator -> () const;
+
+    iterator & operator ++ ();
+
+    bool operator == (const iterator &) const;
+    bool operator != (const iterator &) const;
+  };
+
+private:
+
+  // Members
+
+  engine * _engine;
+  double _time;
+
+  event * _event;
+  record _record;
+  bool _started;
+
+public:
+
+  // Constructors
+
+  stream(engine &, const double &);
+  stream(stream &&);
+  stream(const stream &) = delete;
+
+  // Destructor
+
+  ~stream();
+
+  // Methods
+
+  iterator begin();
+  iterator end();
+
+private:
+
+  // Private methods
+
+  void advance();
+};
+
+#endif
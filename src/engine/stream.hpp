@@ -0,0 +1,24 @@
+#ifndef __nobb__engine__stream__hpp
+#define __nobb__engine__stream__hpp
+
+#include <assert.h>
+
+#include "stream.h"
+#include "event/events/molecule.h"
+#include "event/events/bumper.h"
+#include "event/events/line.h"
+#include "event/reports/molecule.h"
+#include "event/reports/bumper.h"
+#include "event/reports/line.h"
+
+// record
+
+// Getters
+
+template <typename etype> report <etype> stream :: record :: get() const
+{
+  assert(dynamic_cast <const etype *> (this->_event));
+  return report <etype> ((const etype &) (*(this->_event)));
+}
+
+#endif
@@ -22,6 +22,10 @@ class event
 {
 public:
 
+  // Nested enums
+
+  enum kind {grid_kind, molecule_kind, bumper_kind, xline_kind, sample_kind};
+
   // Nested classes
 
   class wrapper
@@ -50,6 +54,10 @@ public:
     operator const event * () const;
   };
 
+  // Friends
+
+  friend class engine;
+
 protected:
 
   // Protected Members
@@ -70,6 +78,7 @@ public:
 
   // Public Methods
 
+  virtual kind type() const = 0;
   virtual bool current() = 0;
   virtual bool resolve() = 0;
   virtual void each(engine *, void (engine :: *)(molecule &, const size_t &)) = 0;
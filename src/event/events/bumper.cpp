@@ -18,6 +18,41 @@ namespace events
 
     double time = molecule.time();
 
+#ifndef __monatomic__
+    if(molecule.size() == 1)
+#endif
+    {
+      // Simple case: first root of |xa - xb + v t|^2 = (ra + rb)^2, in closed form
+
+      vec c = xb - xa;
+      double approach = c * v;
+
+      if(approach <= 0)
+      {
+        this->_happens = false;
+        return;
+      }
+
+      double delta = quadratic :: smaller(~v, -approach, ~c - radiisquared);
+
+      if(std :: isnan(delta))
+      {
+        this->_happens = false;
+        return;
+      }
+
+      this->_happens = true;
+      this->_time = time + std :: max(delta, 0.); // Already touching: the collision happens now
+      this->_molecule.atom = 0;
+      this->_molecule.molecule = &molecule;
+      this->_molecule.version = molecule.version();
+      this->_bumper = &bumper;
+      this->_fold = fold;
+
+      return;
+    }
+
+#ifndef __monatomic__
     bool close;
     double beg = 0.;
     double end;
@@ -97,6 +132,7 @@ namespace events
     }
 
     this->_happens = false;
+#endif
   }
 
   // Geters
@@ -108,6 +144,11 @@ namespace events
 
   // Methods
 
+  event :: kind bumper :: type() const
+  {
+    return bumper_kind;
+  }
+
   bool bumper :: current()
   {
     return static_cast<int32_t>(this->_molecule.version) == this->_molecule.molecule->version();
@@ -186,6 +227,7 @@ namespace events
 
   // Private Methods
 
+#ifndef __monatomic__
   double bumper :: collision(const :: molecule & molecule, const size_t & index, const :: bumper & bumper, const double & beg, const double & end, const int & fold)
   {
     double radiisquared = (molecule[index].radius() + bumper.radius()) * (molecule[index].radius() + bumper.radius());
@@ -205,4 +247,5 @@ namespace events
 
     return (distsquared(zero + time_epsilon) < distsquared(zero)) ? zero : NAN;
   }
+#endif
 }
@@ -26,6 +26,7 @@ namespace events
 #include "elements/bumper.h"
 #include "event/event.h"
 #include "math/newton.h"
+#include "math/quadratic.h"
 #include "math/gss.h"
 #include "math/secant.h"
 
@@ -74,6 +75,7 @@ namespace events
 
     // Methods
 
+    kind type() const;
     bool current();
     bool resolve();
     void each(engine *, void (engine :: *)(:: molecule &, const size_t &));
@@ -83,7 +85,9 @@ namespace events
 
     std :: ostream & print(std :: ostream &) const;
 
+#ifndef __monatomic__
     double collision(const :: molecule &, const size_t &, const :: bumper &, const double &, const double &, const int & = vec :: direct);
+#endif
 
     // Static private methods
 
@@ -8,18 +8,20 @@ namespace events
   grid :: grid (:: molecule & molecule, :: grid & grid)
   {
     //double time = molecule.time();
-    double step = 1. / grid.fineness();
-    double contour = step * 0.01;
+    double xstep = 1. / grid.xfineness(molecule.mark.level());
+    double ystep = 1. / grid.yfineness(molecule.mark.level());
+    double xcontour = xstep * 0.01;
+    double ycontour = ystep * 0.01;
 
-    if(!(molecule.position().x >= step * molecule.mark.x() && molecule.position().y >= step * molecule.mark.y() && molecule.position().x <= step * (molecule.mark.x() + 1) && molecule.position().y <= step * (molecule.mark.y() + 1)))
+    if(!(molecule.position().x >= xstep * molecule.mark.x() && molecule.position().y >= ystep * molecule.mark.y() && molecule.position().x <= xstep * (molecule.mark.x() + 1) && molecule.position().y <= ystep * (molecule.mark.y() + 1)))
     {
-      std::cout << step * molecule.mark.x() << "\t" << molecule.position().x << "\t" << step * (molecule.mark.x() + 1) << "\n";
-      std::cout << step * molecule.mark.y() << "\t" << molecule.position().y << "\t" << step * (molecule.mark.y() + 1) << "\n";
+      std::cout << xstep * molecule.mark.x() << "\t" << molecule.position().x << "\t" << xstep * (molecule.mark.x() + 1) << "\n";
+      std::cout << ystep * molecule.mark.y() << "\t" << molecule.position().y << "\t" << ystep * (molecule.mark.y() + 1) << "\n";
       exit(EXIT_FAILURE);
     }
 
-    double time_x = (step * (molecule.mark.x() + (size_t)(molecule.velocity().x >= 0)) + (contour * (molecule.velocity().x >= 0 ? 1 : -1)) - molecule.position().x) / molecule.velocity().x;
-    double time_y = (step * (molecule.mark.y() + (size_t)(molecule.velocity().y >= 0)) + (contour * (molecule.velocity().y >= 0 ? 1 : -1)) - molecule.position().y) / molecule.velocity().y;
+    double time_x = (xstep * (molecule.mark.x() + (size_t)(molecule.velocity().x >= 0)) + (xcontour * (molecule.velocity().x >= 0 ? 1 : -1)) - molecule.position().x) / molecule.velocity().x;
+    double time_y = (ystep * (molecule.mark.y() + (size_t)(molecule.velocity().y >= 0)) + (ycontour * (molecule.velocity().y >= 0 ? 1 : -1)) - molecule.position().y) / molecule.velocity().y;
 
     if(!std :: isfinite(time_x)) time_x = std :: numeric_limits <double> :: infinity();
     if(!std :: isfinite(time_y)) time_y = std :: numeric_limits <double> :: infinity();
@@ -44,6 +46,11 @@ namespace events
 
   // Methods
 
+  event :: kind grid :: type() const
+  {
+    return grid_kind;
+  }
+
   bool grid :: current()
   {
     return static_cast<int32_t>(this->_molecule.version) == this->_molecule.molecule->version();
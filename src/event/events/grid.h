@@ -52,6 +52,7 @@ namespace events
 
     // Methods
 
+    kind type() const;
     bool current();
     bool resolve();
     void each(engine *, void (engine :: *)(:: molecule &, const size_t &));
@@ -8,9 +8,14 @@ namespace events
   xline :: xline (:: molecule & molecule, const int & fold, :: xline & xline)
   {
     // Working variables
-    double beg, end, delta;
+    double delta;
+#ifndef __monatomic__
+    double beg, end;
+#endif
     // Simple case first (one atom in molecule)
+#ifndef __monatomic__
     if(molecule.size() == 1)
+#endif
     {
       vec xa = molecule.position() + vec(fold);
       double xl = xline.xposition();
@@ -18,11 +23,11 @@ namespace events
       vec v = molecule.velocity();
 
       delta = xa.x - xl;
-      if (std :: signbit(delta) != std :: signbit(v.x))
+      if (v.x != 0 && std :: signbit(delta) != std :: signbit(v.x))
       {
-        double abs_delta = abs(delta) - molecule.radius();
+        double gap = std :: max(fabs(delta) - molecule.radius(), 0.); // Already touching: the crossing happens now
         this->_happens = true;
-        this->_time = molecule.time() + abs(abs_delta / v.x);
+        this->_time = molecule.time() + gap / fabs(v.x);
         this->_molecule.atom = 0;
         this->_molecule.molecule = &molecule;
         this->_molecule.version = molecule.version();
@@ -37,6 +42,7 @@ namespace events
         return;
       }
     }
+#ifndef __monatomic__
     else 
     // Then difficult case
     {
@@ -55,22 +61,22 @@ namespace events
         {
           // They are getting closer and closer...
           // ...until the cdm itself will touch the line!
-          end = beg + abs(delta / v.x);
+          end = beg + fabs(delta / v.x);
         }
         else
         {
           // They are getting far away, until the surrounding circle
           // does not touch xline anymore
           double circle_delta = molecule.radius() - delta;
-          end = beg + abs(circle_delta / v.x);
+          end = beg + fabs(circle_delta / v.x);
         }
       }
       else if(std :: signbit(delta) != std :: signbit(v.x))
       {
         // They are not already close
         // But they are getting closer and closer
-        beg = molecule.time() + abs((delta - molecule.radius()) / v.x);
-        end = molecule.time() + abs(delta / v.x);
+        beg = molecule.time() + fabs((delta - molecule.radius()) / v.x);
+        end = molecule.time() + fabs(delta / v.x);
       }
       else
       {
@@ -114,7 +120,7 @@ namespace events
     }
 
     this->_happens = false;
-    
+#endif
   }
 
   // Geters
@@ -126,6 +132,11 @@ namespace events
 
   // Methods
 
+  event :: kind xline :: type() const
+  {
+    return xline_kind;
+  }
+
   bool xline :: current()
   {
     return static_cast<int32_t>(this->_molecule.version) == this->_molecule.molecule->version();
@@ -147,7 +158,11 @@ namespace events
     // Collision resolution
 
     // Simple case (1 atom molecule)
+#ifndef __monatomic__
     if(this->_molecule.molecule->size() == 1 && this->_xline->x_only())
+#else
+    if(this->_xline->x_only())
+#endif
     {
       bool sign = std :: signbit(this->_molecule.molecule->velocity().x);
         if (this->_xline->temperature() != -1)
@@ -234,6 +249,7 @@ namespace events
 
   // Private Methods
 
+#ifndef __monatomic__
   double xline :: collision(const :: molecule & molecule, const size_t & index, const :: xline & xline, const double & beg, const double & end, const int & fold)
   {
     double radiisquared = (molecule[index].radius()) * (molecule[index].radius());
@@ -254,4 +270,5 @@ namespace events
 
     return (distsquared(zero + time_epsilon) < distsquared(zero)) ? zero : NAN;
   }
+#endif
 }
@@ -72,6 +72,7 @@ namespace events
 
         // Methods
 
+        kind type() const;
         bool current();
         bool resolve();
         void each(engine *, void (engine :: *)(:: molecule &, const size_t &));
@@ -81,7 +82,9 @@ namespace events
 
         std :: ostream &print(std :: ostream &) const;
 
+#ifndef __monatomic__
         double collision(const :: molecule &, const size_t &, const :: xline &, const double &, const double &, const int & = vec :: direct);
+#endif
 
         // Static private methods
 
@@ -2,11 +2,16 @@
 #include "engine/engine.h"
 #include "callback/dispatcher.h"
 
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define __nobb__event__events__molecule__simd
+#endif
+
 namespace events
 {
   // Constructors
 
-  molecule :: molecule(:: molecule & alpha, const int & fold, :: molecule & beta, const double & elasticity)
+  molecule :: molecule(:: molecule & alpha, const int & fold, :: molecule & beta, const engine * engine) : _engine(engine)
   {
     vec xa = alpha.position() + vec(fold);
 
@@ -15,8 +20,6 @@ namespace events
     vec va = alpha.velocity();
     vec vb = beta.velocity();
 
-    double radiisquared = (alpha.radius() + beta.radius()) * (alpha.radius() + beta.radius());
-
     if(alpha.time() > beta.time())
       xb += vb * (alpha.time() - beta.time());
     else
@@ -24,29 +27,21 @@ namespace events
 
     double time = std :: max(alpha.time(), beta.time());
 
+#ifndef __monatomic__
     if(alpha.size() == 1 && beta.size() == 1)
+#endif
     {
-      // SIMPLE CASE
-      vec c = xb - xa;
-      vec v = va - vb;
+      // SIMPLE CASE: first root of |c - v t|^2 = (ra + rb)^2, in closed form
 
-      if (c * v <= 0)
-      {
-        this->_happens = false;
-        return;
-      }
-      double theta = acos(std::min(1.0, (c * v) / ((!c) * (!v))));
-      double d_min = (!c) * sin(theta);
-      double L = (!c) * cos(theta);
+      double delta = contact(xb - xa, va - vb, alpha.radius() + beta.radius());
 
-      if (d_min >= alpha.radius() + beta.radius())
+      if (isinf(delta))
       {
         this->_happens = false;
         return;
       }
 
-      double T = sqrt((alpha.radius() + beta.radius()) * (alpha.radius() + beta.radius()) - d_min * d_min);
-      if(isnan((L - T) / (!v) + time))
+      if(isnan(delta + time))
       {
         std::cout << 
         (alpha.position() + vec(fold)).x << ";" << (alpha.position() + vec(fold)).y << "\t" <<
@@ -57,7 +52,7 @@ namespace events
         beta.time() << std::endl;
         exit(0);
       }
-      this->_time = (L - T) / (!v) + time;
+      this->_time = delta + time;
       this->_alpha.atom = 0;
       this->_beta.atom = 0;
 
@@ -68,97 +63,150 @@ namespace events
       this->_beta.molecule = &beta;
       this->_beta.version = beta.version();
 
-      this->_elasticity = elasticity;
-
       return;
     }
 
-    bool close;
-    double beg = 0.;
-    double end;
+#ifndef __monatomic__
+    // Time range in which the bounding circles overlap: roots of a t^2 + 2 h t + c, in closed form
+
+    double radiisquared = (alpha.radius() + beta.radius()) * (alpha.radius() + beta.radius());
 
     double a = ~(va - vb);
-    double b = 2. * (xa - xb) * (va - vb);
+    double h = (xa - xb) * (va - vb);
     double c = ~(xa - xb) - radiisquared;
 
+    double discriminant = h * h - a * c;
 
-    if(c < 0)
+    if((c >= 0 && h >= 0) || discriminant <= 0 || a == 0) // Not approaching, too far, or no relative motion
     {
-      // Molecules are already close
-
-      close = true;
-      beg = time;
+      this->_happens = false;
+      return;
     }
-    else
-    {
-      close = false;
 
-      // Test 1: molecules approaching
+    double q = -(h + copysign(sqrt(discriminant), h));
 
-      if(b >= 0)
-      {
-        this->_happens = false;
-        return;
-      }
+    double beg = time + std :: max(std :: min(q / a, c / q), 0.); // Already close: the search starts now
+    double end = time + std :: max(q / a, c / q);
 
-      // Test 2: collision range
+    // Conservative advancement on the closest pair of atoms: distances between atoms change at most at this rate
 
-      double beg = newton :: quadratic(a, b, c, time);
+    auto reach = [](const :: molecule & molecule)
+    {
+      double reach = 0.;
 
-      if(std :: isnan(beg))
-      {
-        this->_happens = false;
-        return;
-      }
-    }
+      for(size_t i = 0; i < molecule.size(); i++)
+        reach = std :: max(reach, !(molecule[i].position()));
 
-    // Determine end of collision range
+      return reach;
+    };
 
-    double mid = time + sqrt(~(xa - xb) / ~(va - vb)); // Maximum proximity of molecules centers of mass
-    double beyond = 2. * mid - beg; // Parabolas are symmetric
+    double rate = !(va - vb) + fabs(alpha.angular_velocity()) * reach(alpha) + fabs(beta.angular_velocity()) * reach(beta);
 
-    end = close ? (time + newton :: quadratic(a, b, c, beyond - time)) : beyond;
+    auto gap = [&](const double & time)
+    {
+      double gap = std :: numeric_limits <double> :: infinity();
 
-    double step = 0.5 * std :: min(std :: min(M_PI / fabs(alpha.angular_velocity() + beta.angular_velocity()), M_PI / fabs(alpha.angular_velocity() - beta.angular_velocity())), std :: min(M_PI / fabs(2. * alpha.angular_velocity()), M_PI / fabs(2. * beta.angular_velocity())));
-    // TODO: Find out better euristics for maximum cropping of minima and maxima?
+      for(size_t i = 0; i < alpha.size(); i++)
+        for(size_t j = 0; j < beta.size(); j++)
+          gap = std :: min(gap, !(position(alpha, i, time, fold) - position(beta, j, time)) - (alpha[i].radius() + beta[j].radius()));
 
-    // Look for collisions between atoms
+      return gap;
+    };
 
-    this->_time = std :: numeric_limits <double> :: infinity();
+    double reached = beg;
+    this->_time = advance :: compute(gap, rate, reached, end);
 
-    for(double binbeg = beg; binbeg < end; binbeg += step)
+    if(std :: isnan(this->_time) && reached <= end)
+      this->_time = this->search(alpha, beta, reached, end, fold); // Advancement stalled: reference search on the rest of the range
+    else if(!std :: isnan(this->_time))
     {
-      double binend = std :: min(binbeg + step, end);
+      double closest = std :: numeric_limits <double> :: infinity();
 
       for(size_t i = 0; i < alpha.size(); i++)
         for(size_t j = 0; j < beta.size(); j++)
         {
-          double ctime = collision(alpha, i, beta, j, binbeg, binend, fold);
+          double distance = !(position(alpha, i, this->_time, fold) - position(beta, j, this->_time)) - (alpha[i].radius() + beta[j].radius());
 
-          if(!std :: isnan(ctime) && ctime < this->_time)
+          if(distance < closest)
           {
-            this->_time = ctime;
+            closest = distance;
             this->_alpha.atom = i;
             this->_beta.atom = j;
           }
         }
+    }
 
-      if(this->_time < std :: numeric_limits <double> :: infinity())
-      {
-        this->_happens = true;
-        this->_alpha.molecule = &alpha;
-        this->_alpha.version = alpha.version();
-        this->_alpha.fold = fold;
-        this->_beta.molecule = &beta;
-        this->_beta.version = beta.version();
+    if(std :: isnan(this->_time))
+    {
+      this->_happens = false;
+      return;
+    }
 
-        this->_elasticity = elasticity;
+    this->_happens = true;
+    this->_alpha.molecule = &alpha;
+    this->_alpha.version = alpha.version();
+    this->_alpha.fold = fold;
+    this->_beta.molecule = &beta;
+    this->_beta.version = beta.version();
+#endif
+  }
 
-        return;
-      }
-    }
+  molecule :: molecule(:: molecule & alpha, const int & fold, :: molecule & beta, const double & time, const engine * engine) : _engine(engine)
+  {
+    // Single atom molecules whose contact time was already computed by contacts
+
+    this->_happens = true;
+    this->_time = time;
+
+    this->_alpha.molecule = &alpha;
+    this->_alpha.atom = 0;
+    this->_alpha.version = alpha.version();
+    this->_alpha.fold = fold;
+    this->_beta.molecule = &beta;
+    this->_beta.atom = 0;
+    this->_beta.version = beta.version();
+  }
+
+  // Static methods
 
-    this->_happens = false;
+  bool molecule :: misses(const :: molecule & alpha, const int & fold, const grid :: entry & beta)
+  {
+    // Conservative test on bounding circles only: true if the constructor would certainly not find any collision
+
+    static constexpr double margin = 1. + 1.e-9;
+
+    vec xa = alpha.position() + vec(fold);
+    vec xb = beta.position;
+
+    if(alpha.time() > beta.time)
+      xb += beta.velocity * (alpha.time() - beta.time);
+    else
+      xa += alpha.velocity() * (beta.time - alpha.time());
+
+    vec c = xb - xa;
+    vec v = alpha.velocity() - beta.velocity;
+
+    double radiisquared = (alpha.radius() + beta.radius) * (alpha.radius() + beta.radius) * margin;
+
+    if(~c <= radiisquared)
+      return false; // Already close
+
+    double approach = c * v;
+
+    if(approach <= 0)
+      return true; // Not approaching
+
+    return (~c) - approach * approach / (~v) > radiisquared; // Minimum distance too large
+  }
+
+  void molecule :: contacts(const :: molecule & alpha, const int & fold, const grid :: block & block, double * times)
+  {
+    // The widest kernel the processor supports is picked once
+
+    static const kernel run = select();
+
+    assert(alpha.size() == 1);
+    run(alpha.position() + vec(fold), alpha.velocity(), alpha.time(), alpha.radius(), block, 0, times);
   }
 
   // Getters
@@ -175,6 +223,11 @@ namespace events
 
   // Methods
 
+  event :: kind molecule :: type() const
+  {
+    return molecule_kind;
+  }
+
   bool molecule :: current()
   {
     return static_cast<int32_t>(this->_alpha.version) == this->_alpha.molecule->version() && static_cast<int32_t>(this->_beta.version) == this->_beta.molecule->version();
@@ -207,25 +260,39 @@ namespace events
     this->v1 = this->_alpha.molecule->velocity();
     this->v2 = this->_beta.molecule->velocity();
 
-    this->av1 = this->_alpha.molecule->angular_velocity();
-    this->av2 = this->_beta.molecule->angular_velocity();
-
     double m1 = this->_alpha.molecule->mass();
     double m2 = this->_beta.molecule->mass();
 
+    this->p1 = m1 * this->v1;
+    this->p2 = m2 * this->v2;
+
+    double elasticity = this->_engine ? this->_engine->restitution(*(this->_alpha.molecule), *(this->_beta.molecule), this->_time) : 1.; // Read now: coefficients may have changed since the prediction
+
+#ifndef __monatomic__
+    this->av1 = this->_alpha.molecule->angular_velocity();
+    this->av2 = this->_beta.molecule->angular_velocity();
+
     double i1 = this->_alpha.molecule->inertia_moment();
     double i2 = this->_beta.molecule->inertia_moment();
 
     this->l1 = this->av1 * i1;
     this->l2 = this->av2 * i2;
 
-    this->p1 = m1 * this->v1;
-    this->p2 = m2 * this->v2;
-
     this->r1 = (*(this->_alpha.molecule))[this->_alpha.atom].position() % this->_alpha.molecule->orientation() + (*(this->_alpha.molecule))[this->_alpha.atom].radius() * n;
     this->r2 = (*(this->_beta.molecule))[this->_beta.atom].position() % this->_beta.molecule->orientation() - (*(this->_beta.molecule))[this->_beta.atom].radius() * n;
 
-    this->module = (1. + this->_elasticity) * (-(p1 * n) / (m1) + (p2 * n) / (m2) - (l1 * (r1 ^ n)) / (i1) + (l2 * (r2 ^ n)) / (i2)) / ((1 / m1) + (1 / m2) + (r1 ^ n) * (r1 ^ n) / (i1) + (r2 ^ n) * (r2 ^ n) / (i2)); // Module of the impulse
+    this->module = (1. + elasticity) * (-(p1 * n) / (m1) + (p2 * n) / (m2) - (l1 * (r1 ^ n)) / (i1) + (l2 * (r2 ^ n)) / (i2)) / ((1 / m1) + (1 / m2) + (r1 ^ n) * (r1 ^ n) / (i1) + (r2 ^ n) * (r2 ^ n) / (i2)); // Module of the impulse
+#else
+    // Disks: the impulse is central, no angular terms
+
+    this->av1 = this->av2 = 0.;
+    this->l1 = this->l2 = 0.;
+
+    this->r1 = this->_alpha.molecule->radius() * n;
+    this->r2 = -this->_beta.molecule->radius() * n;
+
+    this->module = (1. + elasticity) * (-(p1 * n) / (m1) + (p2 * n) / (m2)) / ((1 / m1) + (1 / m2)); // Module of the impulse
+#endif
 
     // Update molecules' velocity and angular_velocity
 
@@ -237,8 +304,10 @@ namespace events
 
   void molecule :: each(engine * engine, void (engine :: * callback)(:: molecule &, const size_t &))
   {
+    size_t alpha = this->_alpha.molecule->tag.id(); // The callback might destroy a removed molecule
+
     (engine->*callback)(*(this->_alpha.molecule), 0);
-    (engine->*callback)(*(this->_beta.molecule), this->_alpha.molecule->tag.id());
+    (engine->*callback)(*(this->_beta.molecule), alpha);
   }
 
   void molecule :: callback(dispatcher & dispatcher)
@@ -248,6 +317,40 @@ namespace events
 
   // Private methods
 
+#ifndef __monatomic__
+  double molecule :: search(const :: molecule & alpha, const :: molecule & beta, const double & beg, const double & end, const int & fold)
+  {
+    double step = 0.5 * std :: min(std :: min(M_PI / fabs(alpha.angular_velocity() + beta.angular_velocity()), M_PI / fabs(alpha.angular_velocity() - beta.angular_velocity())), std :: min(M_PI / fabs(2. * alpha.angular_velocity()), M_PI / fabs(2. * beta.angular_velocity())));
+    // TODO: Find out better euristics for maximum cropping of minima and maxima?
+
+    // Look for collisions between atoms
+
+    double time = std :: numeric_limits <double> :: infinity();
+
+    for(double binbeg = beg; binbeg < end; binbeg += step)
+    {
+      double binend = std :: min(binbeg + step, end);
+
+      for(size_t i = 0; i < alpha.size(); i++)
+        for(size_t j = 0; j < beta.size(); j++)
+        {
+          double ctime = collision(alpha, i, beta, j, binbeg, binend, fold);
+
+          if(!std :: isnan(ctime) && ctime < time)
+          {
+            time = ctime;
+            this->_alpha.atom = i;
+            this->_beta.atom = j;
+          }
+        }
+
+      if(time < std :: numeric_limits <double> :: infinity())
+        return time;
+    }
+
+    return NAN;
+  }
+
   double molecule :: collision(const :: molecule & alpha, const size_t & index_alpha, const :: molecule & beta, const size_t & index_beta, const double & beg, const double & end, const int & fold)
   {
     double radiisquared = (alpha[index_alpha].radius() + beta[index_beta].radius()) * (alpha[index_alpha].radius() + beta[index_beta].radius());
@@ -267,4 +370,239 @@ namespace events
 
     return (distsquared(zero + time_epsilon) < distsquared(zero)) ? zero : NAN;
   }
+#endif
+
+  // Static private methods
+
+  // Contact times of single-atom molecules are computed both by the scalar code below and by the vector kernels, that have to
+  // agree bit for bit: no fused multiply-adds from here to the end of the file, whatever the flags of the build
+
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC optimize("fp-contract=off")
+#elif defined(_MSC_VER)
+#pragma fp_contract(off)
+#endif
+
+  double molecule :: contact(const vec & c, const vec & v, const double & radius)
+  {
+    // Smaller root of a t^2 - 2 approach t + gap, +inf if the molecules never get within radius. The discriminant approach^2 - a gap
+    // equals a radius^2 - (c x v)^2: the former cancels down to the grazing distance when the molecules start far apart, the latter
+    // only down to the radius. Coordinates are combined explicitly, in the same order as the vector kernels.
+
+    double approach = c.x * v.x + c.y * v.y;
+    double a = v.x * v.x + v.y * v.y;
+    double cross = c.x * v.y - c.y * v.x;
+    double discriminant = a * (radius * radius) - cross * cross;
+
+    if(approach <= 0 || discriminant <= 0)
+      return std :: numeric_limits <double> :: infinity();
+
+    double gap = (c.x * c.x + c.y * c.y) - radius * radius;
+    return gap / (sqrt(discriminant) + approach); // Citardauq form: no cancellation, since approach > 0
+  }
+
+  molecule :: kernel molecule :: select()
+  {
+#ifdef __nobb__event__events__molecule__simd
+    __builtin_cpu_init();
+
+    if(__builtin_cpu_supports("avx512f"))
+      return avx512;
+
+    if(__builtin_cpu_supports("avx2"))
+      return avx2;
+#endif
+
+    return scalar;
+  }
+
+  void molecule :: scalar(const vec & position, const vec & velocity, const double & time, const double & radius, const grid :: block & block, const size_t & begin, double * times)
+  {
+    // Same steps as the simple case of the constructor: +inf if the molecules never touch, NaN if they already overlap (left to the constructor)
+
+    for(size_t i = begin; i < block.size; i++)
+    {
+      vec xa = position;
+      vec xb = block.positions[i];
+
+      if(time > block.times[i])
+        xb += block.velocities[i] * (time - block.times[i]);
+      else
+        xa += velocity * (block.times[i] - time);
+
+      vec c = xb - xa;
+      double contact = radius + block.radii[i];
+
+      if((c.x * c.x + c.y * c.y) - contact * contact < 0)
+        times[i] = NAN;
+      else
+        times[i] = molecule :: contact(c, velocity - block.velocities[i], contact) + std :: max(time, block.times[i]); // +inf stays +inf
+    }
+  }
+
+#ifdef __nobb__event__events__molecule__simd
+
+  __attribute__((target("avx2"))) void molecule :: avx2(const vec & position, const vec & velocity, const double & time, const double & radius, const grid :: block & block, const size_t & begin, double * times)
+  {
+    static_assert(sizeof(vec) == 2 * sizeof(double), "Columns of vectors are read as interleaved coordinates.");
+
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d infinity = _mm256_set1_pd(std :: numeric_limits <double> :: infinity());
+    const __m256d nan = _mm256_set1_pd(NAN);
+
+    const __m256d pax = _mm256_set1_pd(position.x), pay = _mm256_set1_pd(position.y);
+    const __m256d vax = _mm256_set1_pd(velocity.x), vay = _mm256_set1_pd(velocity.y);
+    const __m256d ta = _mm256_set1_pd(time), ra = _mm256_set1_pd(radius);
+
+    size_t i = begin;
+
+    for(; i + 4 <= block.size; i += 4)
+    {
+      // Four molecules at a time, coordinates deinterleaved (unpack leaves them in order 0, 2, 1, 3)
+
+      const double * positions = (const double *) (block.positions + i);
+      const double * velocities = (const double *) (block.velocities + i);
+
+      __m256d low = _mm256_loadu_pd(positions), high = _mm256_loadu_pd(positions + 4);
+      __m256d pbx = _mm256_permute4x64_pd(_mm256_unpacklo_pd(low, high), 0xd8), pby = _mm256_permute4x64_pd(_mm256_unpackhi_pd(low, high), 0xd8);
+
+      low = _mm256_loadu_pd(velocities);
+      high = _mm256_loadu_pd(velocities + 4);
+      __m256d vbx = _mm256_permute4x64_pd(_mm256_unpacklo_pd(low, high), 0xd8), vby = _mm256_permute4x64_pd(_mm256_unpackhi_pd(low, high), 0xd8);
+
+      __m256d tb = _mm256_loadu_pd(block.times + i), rb = _mm256_loadu_pd(block.radii + i);
+
+      // Both molecules at the latest of their times
+
+      __m256d later = _mm256_cmp_pd(ta, tb, _CMP_GT_OQ);
+      __m256d forward = _mm256_sub_pd(ta, tb), backward = _mm256_sub_pd(tb, ta);
+
+      __m256d xbx = _mm256_blendv_pd(pbx, _mm256_add_pd(pbx, _mm256_mul_pd(vbx, forward)), later);
+      __m256d xby = _mm256_blendv_pd(pby, _mm256_add_pd(pby, _mm256_mul_pd(vby, forward)), later);
+      __m256d xax = _mm256_blendv_pd(_mm256_add_pd(pax, _mm256_mul_pd(vax, backward)), pax, later);
+      __m256d xay = _mm256_blendv_pd(_mm256_add_pd(pay, _mm256_mul_pd(vay, backward)), pay, later);
+
+      __m256d cx = _mm256_sub_pd(xbx, xax), cy = _mm256_sub_pd(xby, xay);
+      __m256d vx = _mm256_sub_pd(vax, vbx), vy = _mm256_sub_pd(vay, vby);
+
+      // Same operations, in the same order, as contact
+
+      __m256d contact = _mm256_add_pd(ra, rb);
+      __m256d squared = _mm256_mul_pd(contact, contact);
+      __m256d approach = _mm256_add_pd(_mm256_mul_pd(cx, vx), _mm256_mul_pd(cy, vy));
+      __m256d a = _mm256_add_pd(_mm256_mul_pd(vx, vx), _mm256_mul_pd(vy, vy));
+      __m256d cross = _mm256_sub_pd(_mm256_mul_pd(cx, vy), _mm256_mul_pd(cy, vx));
+      __m256d discriminant = _mm256_sub_pd(_mm256_mul_pd(a, squared), _mm256_mul_pd(cross, cross));
+      __m256d gap = _mm256_sub_pd(_mm256_add_pd(_mm256_mul_pd(cx, cx), _mm256_mul_pd(cy, cy)), squared);
+
+      __m256d delta = _mm256_div_pd(gap, _mm256_add_pd(_mm256_sqrt_pd(discriminant), approach));
+      __m256d result = _mm256_add_pd(delta, _mm256_max_pd(ta, tb));
+
+      __m256d miss = _mm256_or_pd(_mm256_cmp_pd(approach, zero, _CMP_LE_OQ), _mm256_cmp_pd(discriminant, zero, _CMP_LE_OQ));
+      result = _mm256_blendv_pd(result, infinity, miss);
+      result = _mm256_blendv_pd(result, nan, _mm256_cmp_pd(gap, zero, _CMP_LT_OQ));
+
+      _mm256_storeu_pd(times + i, result);
+    }
+
+    scalar(position, velocity, time, radius, block, i, times);
+  }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized" // Raised from inside the intrinsics headers
+#endif
+
+  __attribute__((target("avx512f"))) void molecule :: avx512(const vec & position, const vec & velocity, const double & time, const double & radius, const grid :: block & block, const size_t & begin, double * times)
+  {
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d infinity = _mm512_set1_pd(std :: numeric_limits <double> :: infinity());
+    const __m512d nan = _mm512_set1_pd(NAN);
+
+    const __m512i xs = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0), ys = _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1);
+
+    const __m512d pax = _mm512_set1_pd(position.x), pay = _mm512_set1_pd(position.y);
+    const __m512d vax = _mm512_set1_pd(velocity.x), vay = _mm512_set1_pd(velocity.y);
+    const __m512d ta = _mm512_set1_pd(time), ra = _mm512_set1_pd(radius);
+
+    size_t i = begin;
+
+    for(; i + 8 <= block.size; i += 8)
+    {
+      // Eight molecules at a time, coordinates deinterleaved across the two loads
+
+      const double * positions = (const double *) (block.positions + i);
+      const double * velocities = (const double *) (block.velocities + i);
+
+      __m512d low = _mm512_loadu_pd(positions), high = _mm512_loadu_pd(positions + 8);
+      __m512d pbx = _mm512_permutex2var_pd(low, xs, high), pby = _mm512_permutex2var_pd(low, ys, high);
+
+      low = _mm512_loadu_pd(velocities);
+      high = _mm512_loadu_pd(velocities + 8);
+      __m512d vbx = _mm512_permutex2var_pd(low, xs, high), vby = _mm512_permutex2var_pd(low, ys, high);
+
+      __m512d tb = _mm512_loadu_pd(block.times + i), rb = _mm512_loadu_pd(block.radii + i);
+
+      // Both molecules at the latest of their times
+
+      __mmask8 later = _mm512_cmp_pd_mask(ta, tb, _CMP_GT_OQ);
+      __m512d forward = _mm512_sub_pd(ta, tb), backward = _mm512_sub_pd(tb, ta);
+
+      __m512d xbx = _mm512_mask_blend_pd(later, pbx, _mm512_add_pd(pbx, _mm512_mul_pd(vbx, forward)));
+      __m512d xby = _mm512_mask_blend_pd(later, pby, _mm512_add_pd(pby, _mm512_mul_pd(vby, forward)));
+      __m512d xax = _mm512_mask_blend_pd(later, _mm512_add_pd(pax, _mm512_mul_pd(vax, backward)), pax);
+      __m512d xay = _mm512_mask_blend_pd(later, _mm512_add_pd(pay, _mm512_mul_pd(vay, backward)), pay);
+
+      __m512d cx = _mm512_sub_pd(xbx, xax), cy = _mm512_sub_pd(xby, xay);
+      __m512d vx = _mm512_sub_pd(vax, vbx), vy = _mm512_sub_pd(vay, vby);
+
+      // Same operations, in the same order, as contact
+
+      __m512d contact = _mm512_add_pd(ra, rb);
+      __m512d squared = _mm512_mul_pd(contact, contact);
+      __m512d approach = _mm512_add_pd(_mm512_mul_pd(cx, vx), _mm512_mul_pd(cy, vy));
+      __m512d a = _mm512_add_pd(_mm512_mul_pd(vx, vx), _mm512_mul_pd(vy, vy));
+      __m512d cross = _mm512_sub_pd(_mm512_mul_pd(cx, vy), _mm512_mul_pd(cy, vx));
+      __m512d discriminant = _mm512_sub_pd(_mm512_mul_pd(a, squared), _mm512_mul_pd(cross, cross));
+      __m512d gap = _mm512_sub_pd(_mm512_add_pd(_mm512_mul_pd(cx, cx), _mm512_mul_pd(cy, cy)), squared);
+
+      __m512d delta = _mm512_div_pd(gap, _mm512_add_pd(_mm512_sqrt_pd(discriminant), approach));
+      __m512d result = _mm512_add_pd(delta, _mm512_max_pd(ta, tb));
+
+      __mmask8 miss = _mm512_cmp_pd_mask(approach, zero, _CMP_LE_OQ) | _mm512_cmp_pd_mask(discriminant, zero, _CMP_LE_OQ);
+      result = _mm512_mask_blend_pd(miss, result, infinity);
+      result = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(gap, zero, _CMP_LT_OQ), result, nan);
+
+      _mm512_storeu_pd(times + i, result);
+    }
+
+    avx2(position, velocity, time, radius, block, i, times); // Every processor with AVX-512 also has AVX2
+  }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#else
+
+  void molecule :: avx2(const vec & position, const vec & velocity, const double & time, const double & radius, const grid :: block & block, const size_t & begin, double * times)
+  {
+    scalar(position, velocity, time, radius, block, begin, times);
+  }
+
+  void molecule :: avx512(const vec & position, const vec & velocity, const double & time, const double & radius, const grid :: block & block, const size_t & begin, double * times)
+  {
+    scalar(position, velocity, time, radius, block, begin, times);
+  }
+
+#endif
+
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT DEFAULT
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
 }
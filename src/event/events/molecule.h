@@ -25,10 +25,12 @@ namespace events
 // Includes
 
 #include "molecule/molecule.h"
-#include "math/newton.h"
+#include "math/quadratic.h"
+#include "math/advance.h"
 #include "math/gss.h"
 #include "math/secant.h"
 #include "event/event.h"
+#include "engine/grid.h"
 
 namespace events
 {
@@ -38,6 +40,10 @@ namespace events
 
     static constexpr double time_epsilon = 1.e-9;
 
+    // Service typedefs
+
+    typedef void (*kernel)(const vec &, const vec &, const double &, const double &, const grid :: block &, const size_t &, double *); // Contact times of a single atom molecule against a block, from the given position of the block
+
     // Friends
 
     friend class report <events :: molecule>;
@@ -59,7 +65,7 @@ namespace events
       unsigned int version;
     } _beta;
 
-    double _elasticity;
+    const engine * _engine; // Looked up for the restitution coefficient when the collision is resolved
 
     // Working members
 
@@ -79,15 +85,22 @@ namespace events
 
     // Constructors
 
-    molecule(:: molecule &, const int &, :: molecule &, const double & = 1.);
+    molecule(:: molecule &, const int &, :: molecule &, const engine * = nullptr);
+    molecule(:: molecule &, const int &, :: molecule &, const double &, const engine * = nullptr);
 
     // Getters
 
     const :: molecule & alpha() const;
     const :: molecule & beta() const;
 
+    // Static methods
+
+    static bool misses(const :: molecule &, const int &, const grid :: entry &);
+    static void contacts(const :: molecule &, const int &, const grid :: block &, double *);
+
     // Methods
 
+    kind type() const;
     bool current();
     bool resolve();
     void each(engine *, void (engine :: *)(:: molecule &, const size_t &));
@@ -97,12 +110,22 @@ namespace events
 
     // Private methods
 
+#ifndef __monatomic__
+    double search(const :: molecule &, const :: molecule &, const double &, const double &, const int & = vec :: direct);
     double collision(const :: molecule &, const size_t &, const :: molecule &, const size_t &, const double &, const double &, const int & = vec :: direct);
+#endif
 
     // Static private methods
 
     static inline vec position(const :: molecule &, const size_t &, const int & = vec :: direct);
     static inline vec position(const :: molecule &, const size_t &, const double &, const int & = vec :: direct);
+
+    static double contact(const vec &, const vec &, const double &);
+
+    static kernel select();
+    static void scalar(const vec &, const vec &, const double &, const double &, const grid :: block &, const size_t &, double *);
+    static void avx2(const vec &, const vec &, const double &, const double &, const grid :: block &, const size_t &, double *);
+    static void avx512(const vec &, const vec &, const double &, const double &, const grid :: block &, const size_t &, double *);
   };
 }
 #endif
@@ -2,6 +2,7 @@
 #define __nobb__event__events__molecule__hpp
 
 #include "molecule.h"
+#include "math/advance.hpp"
 #include "math/gss.hpp"
 #include "math/secant.hpp"
 
@@ -11,13 +12,23 @@ namespace events
 
   inline vec molecule :: position(const :: molecule & molecule, const size_t & index, const int & fold)
   {
+#ifndef __monatomic__
     return molecule.position() + vec(fold) + molecule[index].position() % molecule.orientation();
+#else
+    (void) index; // The atom of a disk sits on its center of mass
+    return molecule.position() + vec(fold);
+#endif
   }
 
   inline vec molecule :: position(const :: molecule & molecule, const size_t & index, const double & time, const int & fold)
   {
     double dt = time - molecule.time();
+#ifndef __monatomic__
     return molecule.position() + vec(fold) + molecule.velocity() * dt + molecule[index].position() % (molecule.orientation() + molecule.angular_velocity() * dt);
+#else
+    (void) index;
+    return molecule.position() + vec(fold) + molecule.velocity() * dt;
+#endif
   }
 }
 
@@ -0,0 +1,48 @@
+#include "sample.h"
+#include "engine/engine.h"
+
+namespace events
+{
+  // Constructors
+
+  sample :: sample(engine & engine, const size_t & index) : _engine(&engine), _index(index), _version(engine._schedule.version)
+  {
+    this->_happens = true;
+    this->_time = engine._schedule.times[index];
+  }
+
+  // Getters
+
+  const size_t & sample :: index() const
+  {
+    return this->_index;
+  }
+
+  // Methods
+
+  event :: kind sample :: type() const
+  {
+    return sample_kind;
+  }
+
+  bool sample :: current()
+  {
+    return this->_version == this->_engine->_schedule.version;
+  }
+
+  bool sample :: resolve()
+  {
+    // Check version (the schedule could have been replaced)
+
+    if(!current())
+      return false;
+
+    this->_engine->sample(*this);
+    return true;
+  }
+
+  void sample :: each(engine *, void (engine :: *)(:: molecule &, const size_t &))
+  {
+    // No molecule is involved
+  }
+}
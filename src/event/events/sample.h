@@ -0,0 +1,51 @@
+// Foward declarations
+
+namespace events
+{
+  class sample;
+}
+
+#if !defined(__forward__) && !defined(__nobb__event__events__sample__h)
+#define __nobb__event__events__sample__h
+
+// Forward includes
+
+#define __forward__
+#include "engine/engine.h"
+#undef __forward__
+
+// Includes
+
+#include "molecule/molecule.h"
+#include "event/event.h"
+
+namespace events
+{
+  class sample : public event
+  {
+    // Members
+
+    engine * _engine;
+    size_t _index;
+    size_t _version;
+
+  public:
+
+    // Constructors
+
+    sample(engine &, const size_t &);
+
+    // Getters
+
+    const size_t & index() const;
+
+    // Methods
+
+    kind type() const;
+    bool current();
+    bool resolve();
+    void each(engine *, void (engine :: *)(:: molecule &, const size_t &));
+  };
+}
+
+#endif
@@ -159,6 +159,11 @@ const double & report <events :: molecule> :: alpha :: mass() const
   return this->_event._alpha.molecule->mass();
 }
 
+bool report <events :: molecule> :: alpha :: tagged(const uint8_t & tag) const
+{
+  return this->_event._alpha.molecule->tag.has(tag);
+}
+
 // beta
 
 // Public nested classes
@@ -315,6 +320,11 @@ const double & report <events :: molecule> :: beta :: mass() const
   return this->_event._beta.molecule->mass();
 }
 
+bool report <events :: molecule> :: beta :: tagged(const uint8_t & tag) const
+{
+  return this->_event._beta.molecule->tag.has(tag);
+}
+
 // Constructors
 
 report <events :: molecule> :: report(const events :: molecule & event) : alpha(event), beta(event), _event(event)
@@ -8,6 +8,7 @@ template <typename> class report;
 // Libraries
 
 #include <stddef.h>
+#include <stdint.h>
 
 // Includes
 
@@ -151,6 +152,8 @@ public:
     const double & orientation() const;
     const double & mass() const;
 
+    bool tagged(const uint8_t &) const;
+
   } alpha;
 
   class beta
@@ -279,6 +282,8 @@ public:
     const double & orientation() const;
     const double & mass() const;
 
+    bool tagged(const uint8_t &) const;
+
   } beta;
 
 private:
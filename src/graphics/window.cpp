@@ -305,11 +305,13 @@ namespace graphics
 
   void window :: grid(const engine &engine)
   {
-    double step = 1. / engine.fineness();
-    for (size_t i = 1; i < engine.fineness(); i++)
-    {
-      line_buffer.push_back(line({step * i, 0.}, {step * i, 1.}));
-      line_buffer.push_back(line({0., step * i}, {1., step * i}));
-    }
+    double xstep = 1. / engine.xfineness();
+    double ystep = 1. / engine.yfineness();
+
+    for (size_t i = 1; i < engine.xfineness(); i++)
+      line_buffer.push_back(line({xstep * i, 0.}, {xstep * i, 1.}));
+
+    for (size_t i = 1; i < engine.yfineness(); i++)
+      line_buffer.push_back(line({0., ystep * i}, {1., ystep * i}));
   }
 }
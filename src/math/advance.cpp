@@ -0,0 +1,5 @@
+#include "advance.hpp"
+
+constexpr double advance :: epsilon;
+constexpr double advance :: probe;
+constexpr unsigned int advance :: rounds;
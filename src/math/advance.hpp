@@ -0,0 +1,25 @@
+#ifndef __nobb__math__advance__hpp
+#define __nobb__math__advance__hpp
+
+#include "advance.h"
+
+// Static methods
+
+template <typename type, typename std :: enable_if <advance :: valid <type> :: value> :: type *> double advance :: compute(const type & f, const double & rate, double & beg, const double & end)
+{
+  // No zero can be closer than gap / rate: steps never overshoot the first contact
+
+  for(unsigned int i = 0; i < rounds && beg <= end; i++)
+  {
+    double gap = f(beg);
+
+    if(gap <= epsilon && f(beg + probe) < gap)
+      return beg;
+
+    beg += std :: max(gap, epsilon) / rate; // Touching but receding: crawl until apart
+  }
+
+  return NAN;
+}
+
+#endif
@@ -0,0 +1,21 @@
+#include "quadratic.h"
+
+namespace quadratic
+{
+  double smaller(const double & a, const double & b, const double & c)
+  {
+    // Roots of a * x^2 + 2 * b * x + c, with a > 0. The root that would subtract two close numbers is obtained from the other one instead (x1 * x2 = c / a)
+
+    double discriminant = b * b - a * c;
+
+    if(discriminant < 0)
+      return NAN;
+
+    double q = (b > 0) ? -(b + sqrt(discriminant)) : (sqrt(discriminant) - b);
+
+    if(b > 0)
+      return q / a;
+
+    return (q > 0) ? c / q : 0.;
+  }
+}
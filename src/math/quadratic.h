@@ -0,0 +1,14 @@
+#if !defined(__forward__) && !defined(__nobb__math__quadratic__h)
+#define __nobb__math__quadratic__h
+
+// Libraries
+
+#include <cmath>
+#include <limits>
+
+namespace quadratic
+{
+  double smaller(const double &, const double &, const double &);
+}
+
+#endif
@@ -30,6 +30,7 @@ private:
   // Friends
 
   friend class molecule;
+  friend class shape;
 
 	// Members
 
@@ -4,52 +4,57 @@
 
 // Constructors
 
-molecule :: molecule()
+molecule :: molecule() : _shape(nullptr)
 {
 }
 
-molecule :: molecule(const std :: vector<atom> & atoms, const vec & position, const vec & velocity, const double & orientation, const double & angular_velocity) :  _position(position), _velocity(velocity), _orientation(orientation), _angular_velocity(angular_velocity), _mass(0), _radius(0), _inertia_moment(0), _time(0), _version(0)
+#ifndef __monatomic__
+
+molecule :: molecule(const std :: vector<atom> & atoms, const vec & position, const vec & velocity, const double & orientation, const double & angular_velocity) :  _position(position), _velocity(velocity), _time(0), _version(0), _orientation(orientation), _angular_velocity(angular_velocity), _shape(shape :: acquire(atoms))
 {
-	this->_size = atoms.size();
-	this->_atoms = new atom[this->_size];
+  this->_radius = this->_shape->radius();
+}
+
+molecule :: molecule(const molecule & m) : _position(m.position()), _velocity(m.velocity()), _time(m.time()), _radius(m.radius()), _version(m.version()), _orientation(m.orientation()), _angular_velocity(m.angular_velocity()), _shape(shape :: acquire(m._shape)), mark(m.mark), tag(m.tag)
+{
+}
 
-  vec center_mass(0, 0);
-	for(size_t i = 0; i < this->_size; i++)
-	{
-		this->_atoms[i] = atoms[i];
-		this->_mass += this->_atoms[i].mass();
+molecule :: molecule(const molecule & m, const vec & position, const vec & velocity, const double & orientation, const double & angular_velocity) : _position(position), _velocity(velocity), _time(0), _radius(m.radius()), _version(0), _orientation(orientation), _angular_velocity(angular_velocity), _shape(shape :: acquire(m._shape))
+{
+}
 
-    center_mass += this->_atoms[i].mass() * this->_atoms[i].position();
-	}
+#else
 
-	center_mass /= this->_mass;
+// Monatomic build: single disks, orientation and angular velocity are accepted and dropped
 
-	for(size_t i = 0; i < this->_size; i++)
-		this->_atoms[i].position(this->_atoms[i].position() - center_mass);
+const double molecule :: still = 0.;
 
-	for(size_t i = 0; i < this->_size; i++)
-    {
-      this->_radius = std :: max(this->_radius, !this->_atoms[i].position() + this->_atoms[i].radius());
-      this->_inertia_moment += this->_atoms[i].mass() * (.5 * pow(this->_atoms[i].radius(), 2) + ~this->_atoms[i].position()); // Steiner's theorem
-    }
+molecule :: molecule(const std :: vector<atom> & atoms, const vec & position, const vec & velocity, const double &, const double &) :  _position(position), _velocity(velocity), _time(0), _version(0), _shape(shape :: acquire(atoms))
+{
+  assert(atoms.size() == 1 && "Monatomic build: molecules must be made of a single atom.");
+  this->_radius = this->_shape->radius();
 }
 
-molecule :: molecule(const molecule & m) : _size(m.size()), _atoms(new atom[m.size()]), _position(m.position()), _velocity(m.velocity()), _orientation(m.orientation()), _angular_velocity(m.angular_velocity()), _mass(m.mass()), _radius(m.radius()), _inertia_moment(m.inertia_moment()), mark(m.mark), tag(m.tag)
+molecule :: molecule(const molecule & m) : _position(m.position()), _velocity(m.velocity()), _time(m.time()), _radius(m.radius()), _version(m.version()), _shape(shape :: acquire(m._shape)), mark(m.mark), tag(m.tag)
 {
-	for(size_t i = 0; i < this->_size; i++)
-		this->_atoms[i] = m[i];
 }
 
+molecule :: molecule(const molecule & m, const vec & position, const vec & velocity, const double &, const double &) : _position(position), _velocity(velocity), _time(0), _radius(m.radius()), _version(0), _shape(shape :: acquire(m._shape))
+{
+}
+
+#endif
+
 molecule :: ~molecule()
 {
-	delete[] this->_atoms;
+	shape :: release(this->_shape);
 }
 
 // Getters
 
 const size_t & molecule :: size() const
 {
-	return this->_size;
+	return this->_shape->size();
 }
 
 const vec & molecule :: position() const
@@ -62,6 +67,8 @@ const vec & molecule :: velocity() const
 	return this->_velocity;
 }
 
+#ifndef __monatomic__
+
 const double & molecule :: orientation() const
 {
 	return this->_orientation;
@@ -72,6 +79,20 @@ const double & molecule :: angular_velocity() const
 	return this->_angular_velocity;
 }
 
+#else
+
+const double & molecule :: orientation() const
+{
+	return still;
+}
+
+const double & molecule :: angular_velocity() const
+{
+	return still;
+}
+
+#endif
+
 const double & molecule :: radius() const
 {
 	return this->_radius;
@@ -79,12 +100,12 @@ const double & molecule :: radius() const
 
 const double & molecule :: mass() const
 {
-	return this->_mass;
+	return this->_shape->mass();
 }
 
 const double & molecule :: inertia_moment() const
 {
-	return this->_inertia_moment;
+	return this->_shape->inertia_moment();
 }
 
 const double & molecule :: time() const
@@ -97,9 +118,18 @@ const int32_t & molecule :: version() const
 	return this->_version;
 }
 
+const shape & molecule :: species() const
+{
+	return *(this->_shape);
+}
+
 double molecule :: energy() const
 {
-  return 0.5 * ( (this->_mass * (~this->_velocity)) + (this->_inertia_moment * this->_angular_velocity * this->_angular_velocity) );
+#ifndef __monatomic__
+  return 0.5 * ( (this->_shape->mass() * (~this->_velocity)) + (this->_shape->inertia_moment() * this->_angular_velocity * this->_angular_velocity) );
+#else
+  return 0.5 * this->_shape->mass() * (~this->_velocity);
+#endif
 }
 
 // Methods
@@ -114,7 +144,9 @@ void molecule :: integrate(const double & time)
 	if(this->_time < time)
   {
     this->_position += this->_velocity * (time - this->_time);
+#ifndef __monatomic__
     this->_orientation += fmod(this->_angular_velocity * (time - this->_time), 2. * M_PI);
+#endif
 
     this->_time = time;
   }
@@ -122,8 +154,16 @@ void molecule :: integrate(const double & time)
 
 void molecule :: impulse(const vec & position, const vec & impulse)
 {
-  this->_velocity = (this->_mass * this->_velocity + impulse) / this->_mass;
-  this->_angular_velocity = (this->_inertia_moment * this->_angular_velocity + (position ^ (impulse))) / this->_inertia_moment;
+  const double & mass = this->_shape->mass();
+
+  this->_velocity = (mass * this->_velocity + impulse) / mass;
+
+#ifndef __monatomic__
+  const double & inertia_moment = this->_shape->inertia_moment();
+  this->_angular_velocity = (inertia_moment * this->_angular_velocity + (position ^ (impulse))) / inertia_moment;
+#else
+  (void) position; // Impulses on a disk are central
+#endif
 }
 
 void molecule :: teleport(const vec :: fold & fold)
@@ -133,10 +173,15 @@ void molecule :: teleport(const vec :: fold & fold)
 
 void molecule :: scale_energy(const double & target)
 {
-  double ratio = sqrt(target / this->energy());
+  this->scale_velocity(sqrt(target / this->energy()));
+}
 
+void molecule :: scale_velocity(const double & ratio)
+{
   this->_velocity *= ratio;
+#ifndef __monatomic__
   this->_angular_velocity *= ratio;
+#endif
 }
 
 void molecule :: velocity_manual_change(const vec & target)
@@ -154,7 +199,31 @@ void molecule :: disable()
 
 const atom & molecule :: operator [] (const size_t & n) const
 {
-	return this->_atoms[n];
+	return (*(this->_shape))[n];
+}
+
+molecule & molecule :: operator = (const molecule & m)
+{
+  // The new shape is acquired before the old one is released: m might share it
+
+  shape * acquired = shape :: acquire(m._shape);
+  shape :: release(this->_shape);
+
+  this->_position = m._position;
+  this->_velocity = m._velocity;
+  this->_time = m._time;
+  this->_radius = m._radius;
+  this->_version = m._version;
+#ifndef __monatomic__
+  this->_orientation = m._orientation;
+  this->_angular_velocity = m._angular_velocity;
+#endif
+  this->_shape = acquired;
+
+  this->mark = m.mark;
+  this->tag = m.tag;
+
+  return *this;
 }
 
 molecule & molecule :: operator ++ ()
@@ -168,4 +237,4 @@ molecule molecule :: operator ++ (int)
   molecule temp = *this;
   ++*this;
   return temp;
-}
\ No newline at end of file
+}
\ No newline at end of file
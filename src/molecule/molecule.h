@@ -18,6 +18,7 @@ class molecule;
 
 #include "geometry/vec.h"
 #include "molecule/atom.h"
+#include "molecule/shape.h"
 #include "engine/grid.h"
 #include "engine/engine.h"
 
@@ -26,23 +27,25 @@ class molecule
 
 public:
 
-  // Members
-
-  size_t _size;
-  atom * _atoms;
+  // Members (hot: read by every prediction and integration)
 
   vec _position;
   vec _velocity;
 
+  double _time;
+  double _radius;
+  int32_t _version;
+
+#ifndef __monatomic__
   double _orientation;
   double _angular_velocity;
+#else
+  static const double still; // Orientation and angular velocity of every molecule of a monatomic build
+#endif
 
-  double _mass;
-  double _radius;
-  double _inertia_moment;
+  // Members (cold: shared shape, read by multi-atom predictions and impulses only)
 
-  double _time;
-  int32_t _version;
+  shape * _shape;
 
 public:
 
@@ -56,6 +59,7 @@ public:
   molecule();
   molecule(const std :: vector<atom> &, const vec & = vec(0, 0), const vec & = vec(0, 0), const double & = 0, const double & = 0);
   molecule(const molecule &);
+  molecule(const molecule &, const vec &, const vec &, const double &, const double &);
 
   // Destructor
 
@@ -73,6 +77,7 @@ public:
   const double & inertia_moment() const;
   const double & time() const;
   const int32_t & version() const;
+  const shape & species() const;
 
   double energy() const;
 
@@ -83,6 +88,7 @@ public:
   void impulse(const vec &, const vec &);
   void teleport(const vec :: fold &);
   void scale_energy(const double &);
+  void scale_velocity(const double &);
 
   // DESPICABLE METHOD!
   void velocity_manual_change(const vec &);
@@ -92,6 +98,7 @@ public:
   // Operators
 
   const atom & operator [] (const size_t &) const;
+  molecule & operator = (const molecule &);
   molecule & operator ++ ();
   molecule operator ++ (int);
 };
@@ -0,0 +1,140 @@
+#include "shape.h"
+
+// shape
+
+// Private constructors
+
+shape :: shape(const std :: vector <atom> & atoms) : _id(autoincrement++), _size(atoms.size()), _atoms(new atom[atoms.size()]), _mass(0), _radius(0), _inertia_moment(0), _references(0)
+{
+  vec center_mass(0, 0);
+
+  for(size_t i = 0; i < this->_size; i++)
+  {
+    this->_atoms[i] = atoms[i];
+    this->_mass += this->_atoms[i].mass();
+
+    center_mass += this->_atoms[i].mass() * this->_atoms[i].position();
+  }
+
+  center_mass /= this->_mass;
+
+  for(size_t i = 0; i < this->_size; i++)
+    this->_atoms[i].position(this->_atoms[i].position() - center_mass);
+
+  for(size_t i = 0; i < this->_size; i++)
+  {
+    this->_radius = std :: max(this->_radius, !this->_atoms[i].position() + this->_atoms[i].radius());
+    this->_inertia_moment += this->_atoms[i].mass() * (.5 * pow(this->_atoms[i].radius(), 2) + ~this->_atoms[i].position()); // Steiner's theorem
+  }
+}
+
+// Private destructor
+
+shape :: ~shape()
+{
+  delete [] this->_atoms;
+}
+
+// Getters
+
+const size_t & shape :: id() const
+{
+  return this->_id;
+}
+
+const size_t & shape :: size() const
+{
+  return this->_size;
+}
+
+const double & shape :: mass() const
+{
+  return this->_mass;
+}
+
+const double & shape :: radius() const
+{
+  return this->_radius;
+}
+
+const double & shape :: inertia_moment() const
+{
+  return this->_inertia_moment;
+}
+
+// Operators
+
+const atom & shape :: operator [] (const size_t & index) const
+{
+  return this->_atoms[index];
+}
+
+// Static methods
+
+size_t shape :: count()
+{
+  std :: lock_guard <std :: mutex> guard(lock);
+  return registry.size();
+}
+
+// Private static methods
+
+shape * shape :: acquire(const std :: vector <atom> & atoms)
+{
+  // Molecules built from the same atoms share the same shape
+
+  std :: vector <double> key;
+  key.reserve(4 * atoms.size());
+
+  for(const atom & atom : atoms)
+  {
+    key.push_back(atom.position().x);
+    key.push_back(atom.position().y);
+    key.push_back(atom.mass());
+    key.push_back(atom.radius());
+  }
+
+  std :: lock_guard <std :: mutex> guard(lock);
+
+  auto entry = registry.find(key);
+  shape * shape = (entry != registry.end()) ? entry->second : (registry[key] = new class shape(atoms));
+
+  shape->_references++;
+  return shape;
+}
+
+shape * shape :: acquire(shape * shape)
+{
+  // Whoever copies a shape already holds a reference to it: it cannot be released meanwhile
+
+  if(shape)
+    shape->_references++;
+
+  return shape;
+}
+
+void shape :: release(shape * shape)
+{
+  if(!shape)
+    return;
+
+  std :: lock_guard <std :: mutex> guard(lock);
+
+  if(--(shape->_references))
+    return;
+
+  for(auto entry = registry.begin(); entry != registry.end(); entry++)
+    if(entry->second == shape)
+    {
+      registry.erase(entry);
+      break;
+    }
+
+  delete shape;
+}
+
+// Private static members
+
+std :: map <std :: vector <double>, shape *> shape :: registry;
+std :: mutex shape :: lock;
+size_t shape :: autoincrement = 0;
\ No newline at end of file
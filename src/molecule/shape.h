@@ -0,0 +1,86 @@
+// Foward declarations
+
+class shape;
+
+#if !defined(__forward__) && !defined(__nobb__molecule__shape__h)
+#define __nobb__molecule__shape__h
+
+// Libraries
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <stddef.h>
+#include <vector>
+
+// Forward includes
+
+#define __forward__
+#include "molecule.h"
+#undef __forward__
+
+// Includes
+
+#include "geometry/vec.h"
+#include "atom.h"
+
+class shape
+{
+  // Friends
+
+  friend class molecule;
+
+  // Members
+
+  size_t _id;
+  size_t _size;
+  atom * _atoms;
+
+  double _mass;
+  double _radius;
+  double _inertia_moment;
+
+  std :: atomic <size_t> _references;
+
+  // Private constructors
+
+  shape(const std :: vector <atom> &);
+
+  // Private destructor
+
+  ~shape();
+
+public:
+
+  // Getters
+
+  const size_t & id() const;
+  const size_t & size() const;
+  const double & mass() const;
+  const double & radius() const;
+  const double & inertia_moment() const;
+
+  // Operators
+
+  const atom & operator [] (const size_t &) const;
+
+  // Static methods
+
+  static size_t count();
+
+private:
+
+  // Private static methods
+
+  static shape * acquire(const std :: vector <atom> &);
+  static shape * acquire(shape *);
+  static void release(shape *);
+
+  // Private static members
+
+  static std :: map <std :: vector <double>, shape *> registry;
+  static std :: mutex lock;
+  static size_t autoincrement;
+};
+
+#endif
@@ -2,6 +2,7 @@
 
 // Libraries
 
+#include <algorithm>
 #include <math.h>
 
 // Includes
@@ -17,6 +18,8 @@ TEST_CASE("Grid works correctly", "[grid]")
     {
         engine my_engine(4);
 
+        REQUIRE(my_engine.fineness() == 4);
+
         molecule my_molecule(
             {{{0.0, 0.0}, 1., 0.01}},
             {0.4, 0.2},
@@ -44,6 +47,34 @@ TEST_CASE("Grid works correctly", "[grid]")
         });
     }
 
+    SECTION("Inserting into an anisotropic grid")
+    {
+        engine my_engine(8, 2);
+
+        REQUIRE(my_engine.xfineness() == 8);
+        REQUIRE(my_engine.yfineness() == 2);
+
+        molecule my_molecule(
+            {{{0.0, 0.0}, 1., 0.01}},
+            {0.4, 0.7},
+            {0., 0.},
+            0., 0.);
+        my_engine.add(my_molecule);
+
+        my_engine.add(xline(0.9));
+
+        my_engine.each<molecule>([](const molecule & current_molecule)
+        {
+            REQUIRE(current_molecule.mark.x() == 3);
+            REQUIRE(current_molecule.mark.y() == 1);
+        });
+
+        my_engine.each<xline>([](const xline & current_xline)
+        {
+            REQUIRE(current_xline.mark.x() == 7);
+        });
+    }
+
     SECTION("Molecule properly navigates the grid")
     {
         engine my_engine(5);
@@ -108,6 +139,42 @@ TEST_CASE("Grid works correctly", "[grid]")
             count += 1;
         });
         REQUIRE(count == 2);
+
+        // Slots of removed molecules are reused under new ids
+
+        size_t id5 = my_engine.add(my_molecule1);
+        size_t id6 = my_engine.add(my_molecule3);
+
+        REQUIRE(id5 != id1);
+        REQUIRE(id5 != id3);
+        REQUIRE(id6 != id1);
+        REQUIRE(id6 != id3);
+        REQUIRE((id5 & 0xffffffff) == (id3 & 0xffffffff));
+        REQUIRE((id6 & 0xffffffff) == (id1 & 0xffffffff));
+        REQUIRE(my_engine.molecule_count() == 4);
+
+        my_engine.tag(id6, 2);
+        my_engine.remove(id2);
+        my_engine.run(1.);
+
+        std::vector<size_t> ids;
+        my_engine.each<molecule>([&](const molecule &current_molecule) {
+            ids.push_back(current_molecule.tag.id());
+        });
+        std::sort(ids.begin(), ids.end());
+
+        std::vector<size_t> expected = {id4, id5, id6};
+        std::sort(expected.begin(), expected.end());
+
+        REQUIRE(ids == expected);
+
+        my_engine.remove(id6);
+
+        count = 0;
+        my_engine.each<molecule>(2, [&](const molecule &current_molecule) {
+            count += 1;
+        });
+        REQUIRE(count == 0);
     }
 
     SECTION("Event tree built properly")
@@ -174,4 +241,247 @@ TEST_CASE("Grid works correctly", "[grid]")
         
         REQUIRE(eng_grid.event_heap_size() == 11);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Regridding works correctly", "[grid] [regrid]")
+{
+    SECTION("Automatic grids follow molecule count and size")
+    {
+        engine my_engine;
+
+        for (int i = 0; i < 10; i++)
+            for (int j = 0; j < 10; j++)
+                my_engine.add(molecule(
+                    {{{0.0, 0.0}, 1., 0.01}},
+                    {0.05 + 0.1 * i, 0.05 + 0.1 * j},
+                    {0., 0.},
+                    0., 0.));
+
+        REQUIRE(my_engine.xfineness() == 6); // Last picked at 64 molecules
+
+        my_engine.run(0.1);
+
+        REQUIRE(my_engine.xfineness() == 7); // sqrt(100 / 2)
+
+        my_engine.add(molecule(
+            {{{0.0, 0.0}, 1., 0.1}},
+            {0.5, 0.5},
+            {0., 0.},
+            0., 0.));
+
+        REQUIRE(my_engine.xfineness() == 5); // Regions wider than a diameter
+    }
+
+    SECTION("Predictions survive a regrid")
+    {
+        engine my_engine(1);
+
+        molecule mol1(
+            {{{{0.0, 0.0}, 1., 0.05}}},
+            {0.20, 0.5},
+            {1, 0});
+        molecule mol2(
+            {{{{0.0, 0.0}, 1., 0.05}}},
+            {0.80, 0.5},
+            {-1, 0});
+
+        my_engine.add(mol1);
+        my_engine.add(mol2);
+
+        int caught_count = 0;
+
+        my_engine.on<events::molecule>([&](const report<events::molecule> my_report) {
+            caught_count += 1;
+        });
+
+        my_engine.run(2.);
+        my_engine.regrid(4, 3);
+
+        REQUIRE(my_engine.xfineness() == 4);
+        REQUIRE(my_engine.yfineness() == 3);
+
+        my_engine.run(5.3);
+
+        REQUIRE(caught_count == 13);
+    }
+
+    SECTION("Reordering the molecules keeps ids and tags")
+    {
+        engine my_engine(4);
+        std::vector<size_t> ids;
+
+        for (int i = 0; i < 20; i++)
+            ids.push_back(my_engine.add(molecule(
+                {{{0.0, 0.0}, 1., 0.01}},
+                {0.05 + 0.3 * ((i * 7) % 20) / 6.5, 0.05 + 0.045 * i},
+                {0.1 * (i % 3), -0.1},
+                0., 0.)));
+
+        my_engine.tag(ids[3], 1);
+        my_engine.tag(ids[11], 1);
+
+        int caught_count = 0;
+
+        my_engine.on<events::molecule>([&](const report<events::molecule> my_report) {
+            caught_count += 1;
+        });
+
+        my_engine.run(1.);
+        my_engine.reorder();
+
+        size_t tagged = 0;
+
+        my_engine.each<molecule>(1, [&](const molecule & current_molecule)
+        {
+            REQUIRE((current_molecule.tag.id() == ids[3] || current_molecule.tag.id() == ids[11]));
+            tagged++;
+        });
+
+        REQUIRE(tagged == 2);
+        REQUIRE(my_engine.molecule_count() == 20);
+
+        my_engine.remove(ids[5]);
+        my_engine.run(3.);
+
+        REQUIRE(my_engine.molecule_count() == 19);
+    }
+}
+
+TEST_CASE("Regridding while events are in flight works correctly", "[grid] [regrid]")
+{
+    // A gas packed in a corner spreads over the box: crossings per collision grow until the automatic grid is rebuilt mid-run
+
+    auto fill = [](engine & my_engine)
+    {
+        for (int i = 0; i < 12; i++)
+            for (int j = 0; j < 12; j++)
+                my_engine.add(molecule(
+                    {{{0.0, 0.0}, 1., 0.004}},
+                    {0.01 + 0.02 * i, 0.01 + 0.02 * j},
+                    {cos(i * 7 + j * 13), sin(i * 7 + j * 13)},
+                    0., 0.));
+    };
+
+    SECTION("Running")
+    {
+        engine my_engine;
+        fill(my_engine);
+
+        size_t initial = my_engine.xfineness();
+        bool regridded = false;
+        int caught_count = 0;
+
+        my_engine.on<events::molecule>([&](const report<events::molecule> my_report) {
+            regridded |= (my_engine.xfineness() != initial);
+            caught_count += 1;
+        });
+
+        my_engine.run(2.);
+
+        REQUIRE(regridded);
+        REQUIRE(caught_count > 0);
+        REQUIRE(my_engine.molecule_count() == 144);
+    }
+
+    SECTION("Streaming")
+    {
+        engine my_engine;
+        fill(my_engine);
+
+        size_t initial = my_engine.xfineness();
+        bool regridded = false;
+        int pulled_count = 0;
+
+        for(const auto & my_record : my_engine.events_until(2.))
+        {
+            report<events::molecule> my_report = my_record.get<events::molecule>();
+            REQUIRE(my_report.alpha.id() != my_report.beta.id());
+
+            regridded |= (my_engine.xfineness() != initial);
+            pulled_count += 1;
+        }
+
+        REQUIRE(regridded);
+        REQUIRE(pulled_count > 0);
+        REQUIRE(my_engine.molecule_count() == 144);
+    }
+}
+
+TEST_CASE("Hierarchical grids work correctly", "[grid] [levels]")
+{
+    SECTION("Elements are stored at the level of their size")
+    {
+        engine my_engine(2);
+        my_engine.regrid(2, 2, 3);
+
+        REQUIRE(my_engine.levels() == 3);
+
+        my_engine.add(molecule(
+            {{{0.0, 0.0}, 1., 0.01}},
+            {0.3, 0.7},
+            {0., 0.},
+            0., 0.));
+        my_engine.add(bumper({0.3, 0.7}, 0.2));
+
+        my_engine.each<molecule>([](const molecule & current_molecule)
+        {
+            REQUIRE(current_molecule.mark.level() == 2);
+            REQUIRE(current_molecule.mark.x() == 2);
+            REQUIRE(current_molecule.mark.y() == 5);
+        });
+
+        my_engine.each<bumper>([](const bumper & current_bumper)
+        {
+            REQUIRE(current_bumper.mark.level() == 0);
+            REQUIRE(current_bumper.mark.x() == 0);
+            REQUIRE(current_bumper.mark.y() == 1);
+        });
+    }
+
+    SECTION("Automatic grids add levels for small molecules")
+    {
+        engine my_engine;
+        my_engine.add(bumper({0.5, 0.5}, 0.1));
+
+        for (int i = 0; i < 36; i++)
+            for (int j = 0; j < 36; j++)
+            {
+                double x = (i + 0.5) / 36, y = (j + 0.5) / 36;
+
+                if ((x - 0.5) * (x - 0.5) + (y - 0.5) * (y - 0.5) < 0.12 * 0.12)
+                    continue;
+
+                my_engine.add(molecule({{{0.0, 0.0}, 1., 0.005}}, {x, y}, {0., 0.}, 0., 0.));
+            }
+
+        REQUIRE(my_engine.xfineness() == 9); // Regions wider than the bumper's reach
+        REQUIRE(my_engine.levels() == 2); // sqrt(1025 / 2) regions for the small molecules
+    }
+
+    SECTION("Collisions across levels are caught")
+    {
+        int counts[2];
+
+        for (int k = 0; k < 2; k++)
+        {
+            engine my_engine(1);
+
+            if (k)
+                my_engine.regrid(2, 2, 4);
+
+            my_engine.add(molecule({{{0.0, 0.0}, 4., 0.1}}, {0.3, 0.5}, {0.5, 0.}, 0., 0.));
+            my_engine.add(molecule({{{0.0, 0.0}, 1., 0.01}}, {0.7, 0.52}, {-1., 0.}, 0., 0.));
+            my_engine.add(molecule({{{0.0, 0.0}, 1., 0.01}}, {0.1, 0.1}, {0.3, 0.7}, 0., 0.));
+
+            counts[k] = 0;
+
+            my_engine.on<events::molecule>([&](const report<events::molecule> my_report) {
+                counts[k] += 1;
+            });
+
+            my_engine.run(10.);
+        }
+
+        REQUIRE(counts[0] > 0);
+        REQUIRE(counts[1] == counts[0]);
+    }
+}
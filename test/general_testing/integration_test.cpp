@@ -67,6 +67,7 @@ TEST_CASE("Molecule integation works correctly", "[engine] [integration]")
         my_engine.run(0.7);
     }
     
+#ifndef __monatomic__
     SECTION("molecule-molecule collision (3 atoms each)")
     {
         engine my_engine(1);
@@ -124,6 +125,7 @@ TEST_CASE("Molecule integation works correctly", "[engine] [integration]")
 
         my_engine.run(0.55);
     }
+#endif
 
     SECTION("Changing elasticity constant works")
     {
@@ -165,6 +167,112 @@ TEST_CASE("Molecule integation works correctly", "[engine] [integration]")
         my_engine.run(0.6);
     }
 
+    SECTION("Changing elasticity constant applies to pending collisions")
+    {
+        engine my_engine(1);
+        my_engine.elasticity(2.0);
+
+        molecule mol1(
+            {{{{0.0, 0.0}, 1., 0.05}}},
+            {0.20, 0.5},
+            {1, 0});
+        molecule mol2(
+            {{{{0.0, 0.0}, 1., 0.05}}},
+            {0.80, 0.5},
+            {-1, 0});
+
+        my_engine.add(mol1);
+        my_engine.add(mol2);
+
+        int caught_count = 0;
+
+        my_engine.on<events::molecule>([&](const report<events::molecule> my_report) {
+            REQUIRE(fabs(my_report.alpha.velocity.delta().x - 1.5) < EPSILON);
+            REQUIRE(fabs(my_report.beta.velocity.delta().x + 1.5) < EPSILON);
+            caught_count += 1;
+        });
+
+        my_engine.run(0.1);
+
+        size_t pending = my_engine.event_heap_size();
+        my_engine.elasticity(0.5);
+
+        REQUIRE(my_engine.event_heap_size() == pending); // Nothing is predicted again
+
+        my_engine.run(0.3);
+
+        REQUIRE(caught_count == 1);
+    }
+
+    SECTION("Resetting the energy rescales pending collisions")
+    {
+        engine my_engine(1);
+
+        size_t id1 = my_engine.add(molecule({{{{0.0, 0.0}, 1., 0.05}}}, {0.20, 0.3}, {1, 0}));
+        my_engine.add(molecule({{{{0.0, 0.0}, 1., 0.05}}}, {0.80, 0.3}, {-1, 0}));
+
+        size_t id3 = my_engine.add(molecule({{{{0.0, 0.0}, 1., 0.05}}}, {0.20, 0.7}, {1, 0}));
+        my_engine.add(molecule({{{{0.0, 0.0}, 1., 0.05}}}, {0.80, 0.7}, {-1, 0}));
+
+        uint8_t tag = 7;
+        my_engine.tag(id3, tag);
+
+        int caught_count = 0;
+
+        my_engine.on<events::molecule>([&](const report<events::molecule> my_report) {
+            double time = (my_report.alpha.id() == id1 || my_report.beta.id() == id1) ? 0.175 : 0.15;
+
+            REQUIRE(fabs(my_report.time() - time) < 1e-9);
+            caught_count += 1;
+        });
+
+        my_engine.run(0.1);
+
+        size_t pending = my_engine.event_heap_size();
+        my_engine.reset.energy.all(8.0); // Every velocity doubles: times are rescaled in place
+
+        REQUIRE(my_engine.event_heap_size() == pending);
+
+        my_engine.reset.energy.tag(tag, 8.0); // Straddling pair: predicted again
+
+        my_engine.run(0.25);
+
+        REQUIRE(caught_count == 2);
+    }
+
+    SECTION("Inelastic collapse is detected and prevented")
+    {
+        // Three molecules in a row with a low restitution coefficient end up in a cluster that collides over and over
+
+        auto setup = [](engine & my_engine) {
+            my_engine.elasticity(0.05);
+            my_engine.watchdog(1e-2, 5);
+
+            my_engine.add(molecule({{{{0.0, 0.0}, 1., 0.05}}}, {0.30, 0.5}, {1, 0}));
+            my_engine.add(molecule({{{{0.0, 0.0}, 1., 0.05}}}, {0.50, 0.5}, {0, 0}));
+            my_engine.add(molecule({{{{0.0, 0.0}, 1., 0.05}}}, {0.70, 0.5}, {-0.8, 0}));
+        };
+
+        engine my_engine(1);
+        setup(my_engine);
+
+        REQUIRE(!my_engine.run(1.0));
+        REQUIRE(my_engine.collapsed().size() == 1);
+        REQUIRE(my_engine.time() < 0.2);
+
+        my_engine.each<molecule>([&](const molecule & my_molecule) {
+            REQUIRE(my_molecule.time() < 0.2); // The run stopped at the collapse
+        });
+
+        engine protected_engine(1);
+        setup(protected_engine);
+        protected_engine.collapse(1e-2);
+
+        REQUIRE(protected_engine.run(1.0));
+        REQUIRE(protected_engine.collapsed().empty());
+        REQUIRE(protected_engine.time() == 1.0);
+    }
+
     SECTION("Changing elasticity constant works (with tags)")
     {
         enum tags{tag1, tag2, tag3};
@@ -234,4 +342,41 @@ TEST_CASE("Molecule integation works correctly", "[engine] [integration]")
         REQUIRE(caught1);
         REQUIRE(caught2);
     }
+
+    SECTION("Restitution coefficients follow tags")
+    {
+        enum tags{tag1, tag2, tag3};
+        engine my_engine(1);
+        my_engine.elasticity(2.0);
+
+        std::vector<size_t> ids;
+
+        for (double y : {0.2, 0.5, 0.8})
+        {
+            ids.push_back(my_engine.add(molecule({{{{0.0, 0.0}, 1., 0.05}}}, {0.20, y}, {1, 0})));
+            ids.push_back(my_engine.add(molecule({{{{0.0, 0.0}, 1., 0.05}}}, {0.80, y}, {-1, 0})));
+        }
+
+        my_engine.tag(ids[0], tag1); // Against an untagged molecule
+        my_engine.tag(ids[2], tag2); // Against a molecule with a different tag
+        my_engine.tag(ids[3], tag3);
+        my_engine.tag(ids[4], tag1); // More than one tag: global coefficient
+        my_engine.tag(ids[4], tag2);
+
+        my_engine.elasticity(tag1, 0.5);
+        my_engine.elasticity(tag2, tag3, 0.25);
+
+        int caught_count = 0;
+
+        my_engine.on<events::molecule>([&](const report<events::molecule> my_report) {
+            double delta = (my_report.alpha.id() == ids[0] || my_report.alpha.id() == ids[1]) ? 1.5 : (my_report.alpha.id() == ids[2] || my_report.alpha.id() == ids[3]) ? 1.25 : 3.0;
+
+            REQUIRE(fabs(fabs(my_report.alpha.velocity.delta().x) - delta) < EPSILON);
+            caught_count += 1;
+        });
+
+        my_engine.run(0.3);
+
+        REQUIRE(caught_count == 3);
+    }
 }
\ No newline at end of file
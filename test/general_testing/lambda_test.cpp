@@ -3,8 +3,31 @@
 // Includes
 
 #include "engine/engine.hpp"
+#include "engine/static_engine.hpp"
 #include "graphics/window.h"
 
+// Observers
+
+struct collision_counter
+{
+    int count = 0;
+
+    void operator () (const report<events::molecule> &)
+    {
+        count += 1;
+    }
+};
+
+struct bumper_counter
+{
+    int count = 0;
+
+    void operator () (const report<events::bumper> &)
+    {
+        count += 1;
+    }
+};
+
 // Tests
 
 TEST_CASE("Tag system and data gathering works correctly", "[data] [tags] [lambdas]")
@@ -279,4 +302,299 @@ TEST_CASE("Tag system and data gathering works correctly", "[data] [tags] [lambd
         REQUIRE(mol_all == 2.0);
         REQUIRE(mol_tag == 1.0);
     }
-}
\ No newline at end of file
+
+    SECTION("Molecules carry many tags")
+    {
+        engine my_engine(1);
+
+        molecule mol1(
+            {{{{0.0, 0.0}, 1., 0.05}}},
+            {0.20, 0.5},
+            {1, 0});
+        molecule mol2(
+            {{{{0.0, 0.0}, 1., 0.05}}},
+            {0.80, 0.5},
+            {-1, 0});
+
+        size_t id1 = my_engine.add(mol1);
+        size_t id2 = my_engine.add(mol2);
+
+        uint8_t tags1[] = {200, 3, 64, 255, 7};
+
+        for (uint8_t tag : tags1)
+            my_engine.tag(id1, tag);
+
+        my_engine.tag(id1, 3);
+        my_engine.tag(id2, 7);
+        my_engine.tag(id2, 9);
+        my_engine.untag(id1, 200);
+
+        int singles = 0;
+        int pairs = 0;
+
+        my_engine.on<events::molecule>(7, [&](const report<events::molecule> my_report) {
+            singles += 1;
+        });
+
+        my_engine.on<events::molecule>(7, 7, [&](const report<events::molecule> my_report) {
+            pairs += 1;
+        });
+
+        my_engine.on<events::molecule>(9, 3, [&](const report<events::molecule> my_report) {
+            pairs += 10;
+        });
+
+        my_engine.run(0.3);
+
+        REQUIRE(singles == 1);
+        REQUIRE(pairs == 11);
+
+        std::vector<uint8_t> tags;
+
+        my_engine.each<molecule>(255, [&](const molecule &current_molecule) {
+            REQUIRE(current_molecule.tag.id() == id1);
+            REQUIRE(current_molecule.tag.size() == 4);
+            REQUIRE(!current_molecule.tag.has(200));
+
+            for (size_t i = 0; i < current_molecule.tag.size(); i++)
+                tags.push_back(current_molecule.tag[i]);
+        });
+
+        REQUIRE(tags == std::vector<uint8_t>({3, 7, 64, 255}));
+
+        int count = 0;
+        REQUIRE(my_engine.remove(id1));
+        my_engine.each<molecule>(7, [&](const molecule &current_molecule) {
+            count += 1;
+        });
+
+        REQUIRE(count == 1);
+
+        // The slot of id1 is reused under a new id: the stale one must not reach the new molecule
+
+        size_t id3 = my_engine.add(mol1);
+
+        REQUIRE(id3 != id1);
+        REQUIRE(!my_engine.remove(id1));
+        REQUIRE(!my_engine.tag(id1, 11));
+        REQUIRE(!my_engine.untag(id1, 7));
+        REQUIRE(!my_engine.reset.energy.id(id1, 1.));
+
+        REQUIRE(my_engine.tag(id3, 11));
+        REQUIRE(my_engine.molecule_count() == 2);
+
+        count = 0;
+        my_engine.each<molecule>(11, [&](const molecule &current_molecule) {
+            REQUIRE(current_molecule.tag.id() == id3);
+            count += 1;
+        });
+
+        REQUIRE(count == 1);
+    }
+}
+
+TEST_CASE("Static subscriptions work correctly", "[data] [lambdas] [static]")
+{
+    SECTION("Observers receive only the events they accept")
+    {
+        static_engine<collision_counter, bumper_counter> my_engine(1, collision_counter(), bumper_counter());
+        engine reference_engine(1);
+
+        molecule mol1(
+            {{{{0.0, 0.0}, 1., 0.05}}},
+            {0.20, 0.5},
+            {1, 0});
+        molecule mol2(
+            {{{{0.0, 0.0}, 1., 0.05}}},
+            {0.80, 0.5},
+            {-1, 0});
+        molecule mol3(
+            {{{{0.0, 0.0}, 1., 0.05}}},
+            {0.15, 0.85},
+            {0, 1});
+
+        bumper bum({0.15, 0.15}, 0.05);
+
+        my_engine.add(mol1);
+        my_engine.add(mol2);
+        my_engine.add(mol3);
+        my_engine.add(bum);
+
+        reference_engine.add(mol1);
+        reference_engine.add(mol2);
+        reference_engine.add(mol3);
+        reference_engine.add(bum);
+
+        int molecule_count = 0;
+        int bumper_count = 0;
+
+        reference_engine.on<events::molecule>([&](const report<events::molecule> my_report) {
+            molecule_count += 1;
+        });
+
+        reference_engine.on<events::bumper>([&](const report<events::bumper> my_report) {
+            bumper_count += 1;
+        });
+
+        my_engine.run(5.3);
+        reference_engine.run(5.3);
+
+        REQUIRE(molecule_count > 0);
+        REQUIRE(bumper_count > 0);
+
+        REQUIRE(my_engine.observer<collision_counter>().count == molecule_count);
+        REQUIRE(my_engine.observer<bumper_counter>().count == bumper_count);
+    }
+
+    SECTION("Engine without observers runs the same simulation")
+    {
+        static_engine<> my_engine(1);
+
+        molecule mol1(
+            {{{{0.0, 0.0}, 1., 0.05}}},
+            {0.20, 0.5},
+            {1, 0});
+
+        my_engine.add(mol1);
+        my_engine.run(0.5);
+
+        my_engine.each<molecule>([](const molecule &current_molecule) {
+            REQUIRE(fabs(current_molecule.position().x - 0.7) < 1.e-12);
+        });
+    }
+}
+
+TEST_CASE("Pull-based event stream works correctly", "[data] [stream]")
+{
+    SECTION("Stream yields the same events as subscriptions")
+    {
+        engine my_engine(1);
+
+        molecule mol1(
+            {{{{0.0, 0.0}, 1., 0.05}}},
+            {0.20, 0.5},
+            {1, 0});
+        molecule mol2(
+            {{{{0.0, 0.0}, 1., 0.05}}},
+            {0.80, 0.5},
+            {-1, 0});
+
+        my_engine.add(mol1);
+        my_engine.add(mol2);
+
+        int pushed_count = 0;
+        int pulled_count = 0;
+
+        my_engine.on<events::molecule>([&](const report<events::molecule> my_report) {
+            pushed_count += 1;
+        });
+
+        for(const auto & my_record : my_engine.events_until(5.3))
+        {
+            REQUIRE(my_record.type() == event::molecule_kind);
+            REQUIRE(my_record.time() <= 5.3);
+            pulled_count += 1;
+        }
+
+        REQUIRE(pulled_count == 13);
+        REQUIRE(pushed_count == 13);
+    }
+
+    SECTION("Stream can be stopped early")
+    {
+        engine my_engine(1);
+
+        molecule mol1(
+            {{{{0.0, 0.0}, 1., 0.05}}},
+            {0.20, 0.5},
+            {1, 0});
+        molecule mol2(
+            {{{{0.0, 0.0}, 1., 0.05}}},
+            {0.80, 0.5},
+            {-1, 0});
+
+        my_engine.add(mol1);
+        my_engine.add(mol2);
+
+        double time = 0;
+
+        for(const auto & my_record : my_engine.events_until(5.3))
+        {
+            report<events::molecule> my_report = my_record.get<events::molecule>();
+            REQUIRE(fabs(my_report.alpha.velocity.delta().x - 2.0) < 1.e-12);
+
+            time = my_record.time();
+            break;
+        }
+
+        REQUIRE(fabs(time - 0.25) < 1.e-12);
+
+        my_engine.each<molecule>([](const molecule &current_molecule) {
+            REQUIRE(fabs(current_molecule.time() - 0.25) < 1.e-12);
+        });
+
+        int caught_count = 0;
+
+        my_engine.on<events::molecule>([&](const report<events::molecule> my_report) {
+            caught_count += 1;
+        });
+
+        my_engine.run(5.3);
+
+        REQUIRE(caught_count == 12);
+    }
+}
+
+TEST_CASE("Scheduled samples work correctly", "[data] [schedule]")
+{
+    SECTION("Samples fire at the scheduled times within a single run")
+    {
+        engine my_engine(1);
+
+        molecule mol1(
+            {{{{0.0, 0.0}, 1., 0.05}}},
+            {0.20, 0.5},
+            {1, 0});
+        molecule mol2(
+            {{{{0.0, 0.0}, 1., 0.05}}},
+            {0.80, 0.5},
+            {-1, 0});
+
+        my_engine.add(mol1);
+        my_engine.add(mol2);
+
+        std::vector<double> times = {0., 0.1, 0.3, 0.5, 1.7};
+        std::vector<double> positions;
+
+        my_engine.schedule(times, [&](const size_t &index, const double &time) {
+            REQUIRE(index == positions.size());
+            REQUIRE(time == times[index]);
+
+            double sum = 0;
+
+            my_engine.each<molecule>([&](const molecule &current_molecule) {
+                REQUIRE(current_molecule.time() == time);
+                sum += fabs(current_molecule.position().x - 0.5);
+            });
+
+            positions.push_back(sum);
+        });
+
+        int caught_count = 0;
+
+        my_engine.on<events::molecule>([&](const report<events::molecule> my_report) {
+            caught_count += 1;
+        });
+
+        my_engine.run(2.);
+
+        REQUIRE(positions.size() == times.size());
+        REQUIRE(caught_count == 5);
+
+        // Molecules approach each other until the first collision at 0.25
+
+        REQUIRE(fabs(positions[0] - 0.6) < 1.e-12);
+        REQUIRE(fabs(positions[1] - 0.4) < 1.e-12);
+        REQUIRE(fabs(positions[2] - 0.2) < 1.e-12);
+    }
+}
@@ -0,0 +1,133 @@
+#include "catch.hpp"
+
+// Libraries
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Includes
+
+#include "math/advance.hpp"
+#include "math/gss.hpp"
+#include "math/secant.hpp"
+#include "engine/engine.hpp"
+#include "event/events/molecule.h"
+
+// Tests
+
+TEST_CASE("Conservative advancement finds the first zero of a gap.")
+{
+    SECTION("Linear gaps are reached in one step")
+    {
+        auto f = [&](const double & x)
+        {
+            return 3. - 2. * x;
+        };
+
+        double beg = 0;
+
+        REQUIRE(advance :: compute(f, 2, beg, 10) == 1.5);
+    }
+
+    SECTION("Gaps of a rotating point agree with the golden section and secant reference")
+    {
+        // Distance of a point spinning on the unit circle from a disk of radius 0.5 centered in (1.3, 0.3)
+
+        auto f = [&](const double & x)
+        {
+            return sqrt(pow(cos(3. * x + 2.) - 1.3, 2) + pow(sin(3. * x + 2.) - 0.3, 2)) - 0.5;
+        };
+
+        double beg = 0;
+        double zero = advance :: compute(f, 3, beg, 10);
+
+        auto g = [&](const double & x) // Squared distance, as in the multi-atom search
+        {
+            return pow(cos(3. * x + 2.) - 1.3, 2) + pow(sin(3. * x + 2.) - 0.3, 2) - 0.25;
+        };
+
+        double min = gss :: min(g, 0, 2);
+        double reference = secant :: compute(g, gss :: max(g, 0, min), min);
+
+        REQUIRE(fabs(f(zero)) <= advance :: epsilon);
+        REQUIRE(fabs(zero - reference) <= 1e-9);
+    }
+
+    SECTION("Receding and missing gaps")
+    {
+        auto f = [&](const double & x)
+        {
+            return x;
+        };
+
+        double beg = 0;
+
+        REQUIRE(std :: isnan(advance :: compute(f, 1, beg, 1)));
+        REQUIRE(beg > 0);
+
+        auto g = [&](const double & x)
+        {
+            return 1 + pow(x - 1, 2);
+        };
+
+        beg = 0;
+
+        REQUIRE(std :: isnan(advance :: compute(g, 4, beg, 2)));
+        REQUIRE(beg > 2);
+    }
+}
+
+#ifndef __monatomic__
+TEST_CASE("Multi atom predictors find the first contact.", "[events]")
+{
+    std :: default_random_engine generator(7);
+    std :: uniform_real_distribution <double> unit(0, 1), signed_unit(-1, 1);
+
+    auto position = [](const molecule & molecule, const size_t & index, const double & time)
+    {
+        double dt = time - molecule.time();
+        return molecule.position() + molecule.velocity() * dt + molecule[index].position() % (molecule.orientation() + molecule.angular_velocity() * dt);
+    };
+
+    size_t found = 0;
+
+    for(size_t k = 0; k < 100; k++)
+    {
+        molecule alpha({atom({0, 0}, 1, 0.01), atom({0.02, 0}, 1, 0.01), atom({0.01, 0.015}, 2, 0.007)}, {0.3 + 0.1 * unit(generator), 0.5 + 0.1 * signed_unit(generator)}, {signed_unit(generator), signed_unit(generator)}, 6 * unit(generator), 30 * signed_unit(generator));
+        molecule beta({atom({0, 0}, 1, 0.012), atom({0.025, 0.005}, 3, 0.009)}, {0.45 + 0.1 * unit(generator), 0.5 + 0.1 * signed_unit(generator)}, {signed_unit(generator), signed_unit(generator)}, 6 * unit(generator), 30 * signed_unit(generator));
+
+        auto gap = [&](const double & time)
+        {
+            double gap = std :: numeric_limits <double> :: infinity();
+
+            for(size_t i = 0; i < alpha.size(); i++)
+                for(size_t j = 0; j < beta.size(); j++)
+                    gap = std :: min(gap, !(position(alpha, i, time) - position(beta, j, time)) - (alpha[i].radius() + beta[j].radius()));
+
+            return gap;
+        };
+
+        if(gap(0) <= 0)
+            continue;
+
+        events :: molecule event(alpha, vec :: direct, beta);
+
+        double horizon = event.happens() ? event.time() : 1.;
+        double closest = std :: numeric_limits <double> :: infinity();
+
+        for(double time = 0; time < horizon; time += 1e-4)
+            closest = std :: min(closest, gap(time));
+
+        REQUIRE(closest > 0); // No contact skipped
+
+        if(event.happens())
+        {
+            found++;
+            REQUIRE(fabs(gap(event.time())) <= 1e-9);
+        }
+    }
+
+    REQUIRE(found > 0);
+}
+#endif
@@ -0,0 +1,224 @@
+#include "catch.hpp"
+
+// Libraries
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Includes
+
+#include "math/quadratic.h"
+#include "engine/engine.hpp"
+#include "event/events/molecule.h"
+#include "event/events/bumper.h"
+#include "event/events/line.h"
+
+// Tests
+
+TEST_CASE("Quadratic computes accurately the smaller root of a parabola.")
+{
+    SECTION("Well conditioned roots")
+    {
+        REQUIRE(fabs(quadratic :: smaller(1, -3, 5) - 1) <= 4 * std :: numeric_limits <double> :: epsilon()); // x^2 - 6x + 5
+        REQUIRE(fabs(quadratic :: smaller(2, 1, -4) + 2) <= 4 * std :: numeric_limits <double> :: epsilon()); // 2x^2 + 2x - 4
+        REQUIRE(quadratic :: smaller(1, -1, 1) == 1); // Double root
+        REQUIRE(quadratic :: smaller(1, 0, 0) == 0);
+        REQUIRE(std :: isnan(quadratic :: smaller(1, 1, 2)));
+    }
+
+    SECTION("Roots that the textbook formula would cancel")
+    {
+        // x^2 - 2e8 x + 1: the smaller root is 1 / (1e8 + sqrt(1e16 - 1)), the textbook formula returns 0
+
+        double root = quadratic :: smaller(1, -1e8, 1);
+        REQUIRE(fabs(root / 5e-9 - 1) <= 4 * std :: numeric_limits <double> :: epsilon());
+
+        // Same parabola, scaled like a slow approach of two far molecules
+
+        root = quadratic :: smaller(1e-12, -1e-4, 1e-8);
+        REQUIRE(fabs(root / 5e-5 - 1) <= 1e-12);
+    }
+}
+
+TEST_CASE("Single atom predictors are accurate.", "[events]")
+{
+    std :: default_random_engine generator(42);
+    std :: uniform_real_distribution <double> position(0.1, 0.9), velocity(-1, 1), radius(0.001, 0.05);
+
+    const double tolerance = 1e-12;
+
+    SECTION("Molecule-molecule")
+    {
+        size_t found = 0;
+
+        for(size_t i = 0; i < 1000; i++)
+        {
+            molecule alpha({{{{0.0, 0.0}, 1., radius(generator)}}}, {position(generator), position(generator)}, {velocity(generator), velocity(generator)});
+            molecule beta({{{{0.0, 0.0}, 1., radius(generator)}}}, {position(generator), position(generator)}, {velocity(generator), velocity(generator)});
+
+            double contact = alpha.radius() + beta.radius();
+
+            if((!(alpha.position() - beta.position())) <= contact)
+                continue;
+
+            events :: molecule event(alpha, vec :: direct, beta);
+
+            // Minimum distance of the centers over the free flight, in closed form
+
+            vec c = beta.position() - alpha.position();
+            vec v = alpha.velocity() - beta.velocity();
+            double closest = std :: max(0., (c * v) / (~v));
+
+            if(!event.happens())
+            {
+                REQUIRE((!(c - v * closest)) >= contact * (1 - tolerance));
+                continue;
+            }
+
+            found++;
+
+            double time = event.time();
+            REQUIRE(time >= 0);
+            REQUIRE(time <= closest);
+            REQUIRE(fabs(!(c - v * time) / contact - 1) <= tolerance);
+        }
+
+        REQUIRE(found > 0);
+    }
+
+    SECTION("Molecule-molecule (grazing)")
+    {
+        // Molecules whose centers pass at a distance just below the sum of the radii, both at distances comparable to the radii and much larger
+
+        for(double size : {0.05, 0.005})
+            for(double offset : {1e-3, 1e-6, 1e-9})
+            {
+                molecule alpha({{{{0.0, 0.0}, 1., size}}}, {0.2, 0.5}, {1, 0});
+                molecule beta({{{{0.0, 0.0}, 1., size}}}, {0.8, 0.5 + 2 * size * (1 - offset)}, {0, 0});
+
+                events :: molecule event(alpha, vec :: direct, beta);
+
+                REQUIRE(event.happens());
+
+                // The offset is taken from the positions as stored (gap is exact), and the expression below is free of cancellation
+
+                double contact = alpha.radius() + beta.radius();
+                double gap = contact - (beta.position().y - alpha.position().y);
+
+                double distance = beta.position().x - alpha.position().x;
+                double grazing = sqrt(gap * (2 * contact - gap));
+                double expected = distance - grazing;
+
+                // The contact time moves by distance * contact / grazing times any relative error on the lateral offset: that much is the
+                // conditioning of the problem, the predictor must not add to it
+
+                REQUIRE(fabs(event.time() - expected) <= std :: max(tolerance * expected, 4 * std :: numeric_limits <double> :: epsilon() * distance * contact / grazing));
+            }
+    }
+
+    SECTION("Molecule-molecule (batch)")
+    {
+        // Contact times against a whole block of molecules, whatever kernel the processor runs, are the ones of the constructor
+
+        std :: vector <molecule> betas;
+
+        for(size_t i = 0; i < 37; i++)
+            betas.push_back(molecule({{{{0.0, 0.0}, 1., radius(generator)}}}, {position(generator), position(generator)}, {velocity(generator), velocity(generator)}));
+
+        std :: vector <vec> positions, velocities;
+        std :: vector <double> times, radii;
+        std :: vector <size_t> ids;
+        std :: vector <molecule *> molecules;
+
+        for(molecule & beta : betas)
+        {
+            positions.push_back(beta.position());
+            velocities.push_back(beta.velocity());
+            times.push_back(beta.time());
+            radii.push_back(beta.radius());
+            ids.push_back(0);
+            molecules.push_back(&beta);
+        }
+
+        grid :: block block {positions.data(), velocities.data(), times.data(), radii.data(), ids.data(), molecules.data(), betas.size()};
+        std :: vector <double> contacts(betas.size());
+
+        for(size_t i = 0; i < 100; i++)
+        {
+            molecule alpha({{{{0.0, 0.0}, 1., radius(generator)}}}, {position(generator), position(generator)}, {velocity(generator), velocity(generator)});
+
+            events :: molecule :: contacts(alpha, vec :: direct, block, contacts.data());
+
+            for(size_t j = 0; j < betas.size(); j++)
+            {
+                events :: molecule event(alpha, vec :: direct, betas[j]);
+
+                if(std :: isnan(contacts[j]))
+                    REQUIRE((!(alpha.position() - betas[j].position())) < alpha.radius() + betas[j].radius());
+                else if(event.happens())
+                    REQUIRE(contacts[j] == event.time());
+                else
+                    REQUIRE(std :: isinf(contacts[j]));
+            }
+        }
+    }
+
+    SECTION("Molecule-bumper")
+    {
+        size_t found = 0;
+
+        for(size_t i = 0; i < 1000; i++)
+        {
+            molecule alpha({{{{0.0, 0.0}, 1., radius(generator)}}}, {position(generator), position(generator)}, {velocity(generator), velocity(generator)});
+            bumper beta({position(generator), position(generator)}, radius(generator));
+
+            double contact = alpha.radius() + beta.radius();
+
+            if((!(alpha.position() - beta.position())) <= contact)
+                continue;
+
+            events :: bumper event(alpha, vec :: direct, beta);
+
+            vec c = beta.position() - alpha.position();
+            vec v = alpha.velocity();
+            double closest = std :: max(0., (c * v) / (~v));
+
+            if(!event.happens())
+            {
+                REQUIRE((!(c - v * closest)) >= contact * (1 - tolerance));
+                continue;
+            }
+
+            found++;
+
+            double time = event.time();
+            REQUIRE(time >= 0);
+            REQUIRE(time <= closest);
+            REQUIRE(fabs(!(c - v * time) / contact - 1) <= tolerance);
+        }
+
+        REQUIRE(found > 0);
+    }
+
+    SECTION("Molecule-xline")
+    {
+        for(size_t i = 0; i < 1000; i++)
+        {
+            molecule alpha({{{{0.0, 0.0}, 1., radius(generator)}}}, {position(generator), position(generator)}, {velocity(generator), velocity(generator)});
+            xline beta(position(generator));
+
+            double delta = alpha.position().x - beta.xposition();
+
+            if(fabs(delta) <= alpha.radius())
+                continue;
+
+            events :: xline event(alpha, vec :: direct, beta);
+
+            REQUIRE(event.happens() == (delta * alpha.velocity().x < 0));
+
+            if(event.happens())
+                REQUIRE(fabs(fabs(alpha.position().x + alpha.velocity().x * event.time() - beta.xposition()) / alpha.radius() - 1) <= 1e-9);
+        }
+    }
+}
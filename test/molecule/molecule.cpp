@@ -12,6 +12,7 @@
 
 // Tests
 
+#ifndef __monatomic__
 TEST_CASE("Molecule initialize correctly", "[constructors] [printers]")
 {
   SECTION("Initializing")
@@ -31,4 +32,79 @@ TEST_CASE("Molecule initialize correctly", "[constructors] [printers]")
     REQUIRE(m.inertia_moment() == 24.);
     REQUIRE(m.mass() == 4.);
   }
+
+  SECTION("Placing copies of a prototype")
+  {
+    std :: vector<atom> a;
+
+    a.push_back(atom({3, 4}, 1, 1));
+    a.push_back(atom({-3, 4}, 1, 1));
+
+    molecule prototype(a);
+    molecule m(prototype, {10, 20}, {1, -1}, 0.5, 2.);
+
+    REQUIRE(m.size() == 2);
+    REQUIRE(m[0].position() == prototype[0].position());
+    REQUIRE(m.position() == vec(10, 20));
+    REQUIRE(m.velocity() == vec(1, -1));
+    REQUIRE(m.orientation() == 0.5);
+    REQUIRE(m.angular_velocity() == 2.);
+    REQUIRE(m.inertia_moment() == prototype.inertia_moment());
+    REQUIRE(m.tag.id() == 0); // Ids are handed out by the engine the molecule is added to
+  }
+
+  SECTION("Molecules with the same atoms share their shape")
+  {
+    std :: vector<atom> a;
+
+    a.push_back(atom({1, 7}, 3, 1));
+    a.push_back(atom({-1, 7}, 3, 1));
+
+    size_t shapes = shape :: count();
+
+    {
+      molecule first(a);
+      molecule second(a, {5, 5});
+      molecule copy(first, {1, 1}, {0, 0}, 0, 0);
+
+      REQUIRE(shape :: count() == shapes + 1);
+      REQUIRE(&(first.species()) == &(second.species()));
+      REQUIRE(&(first.species()) == &(copy.species()));
+      REQUIRE(second.mass() == 6.);
+
+      a.push_back(atom({0, 9}, 1, 1));
+      molecule other(a);
+
+      REQUIRE(shape :: count() == shapes + 2);
+      REQUIRE(other.species().id() != first.species().id());
+
+      copy = other;
+
+      REQUIRE(&(copy.species()) == &(other.species()));
+      REQUIRE(copy.size() == 3);
+    }
+
+    REQUIRE(shape :: count() == shapes);
+  }
+}
+#else
+TEST_CASE("Monatomic molecules carry no rotation", "[constructors]")
+{
+  SECTION("Rotation is dropped")
+  {
+    molecule m({{{0, 0}, 2, 0.5}}, {1, 1}, {3, 4}, 0.5, 2.);
+
+    REQUIRE(m.size() == 1);
+    REQUIRE(m.orientation() == 0);
+    REQUIRE(m.angular_velocity() == 0);
+    REQUIRE(m.energy() == 25.);
+
+    m.impulse({0.5, 0}, {0, 2});
+    m.integrate(1);
+
+    REQUIRE(m.velocity() == vec(3, 5));
+    REQUIRE(m.position() == vec(4, 6));
+    REQUIRE(m.angular_velocity() == 0);
+  }
 }
+#endif